@@ -0,0 +1,113 @@
+#pragma once
+
+#include "frame_arena.h"
+#include "profiler.h"
+#include "thread_pool.h"
+#include "../../physics/include/motion.h"
+#include <cstdint>
+
+namespace archimedes3d {
+
+// Forward declarations
+class World;
+
+/**
+ * Multi-rate stepping: each World region advances at timeStep / 2^level,
+ * with the level picked every step from the activity of its bodies. Setting
+ * maxDisplacement, maxVelocityChange or contactsPerLevel to 0 switches that
+ * criterion off.
+ */
+struct MultiRateSettings {
+    bool enabled = false;
+    uint8_t maxLevel = 3;              // Finest substep is timeStep / 2^maxLevel (at most 7)
+    double maxDisplacement = 0.05;     // m a body may travel in one substep
+    double maxVelocityChange = 0.5;    // m/s external fields and buoyancy may add in one substep
+    uint32_t contactsPerLevel = 32;    // Ground impacts in a region that ask for one finer level;
+                                       // every doubling of the count asks for another
+};
+
+/**
+ * Engine configuration
+ */
+struct EngineSettings {
+    double timeStep = 1.0 / 60.0;   // s
+    MotionSettings motion;
+    MultiRateSettings multiRate;
+};
+
+/**
+ * Advances a World through fixed steps of medium sampling, buoyancy-driven
+ * integration and sleep detection.
+ *
+ * With multi-rate stepping enabled, calm regions of the World's floating-origin
+ * grid take one coarse step while active ones subcycle. A region's level
+ * follows its fastest body, strongest acceleration and ground-impact count.
+ * Every level divides the coarse step, so all regions meet again at each step
+ * boundary; that is where levels are re-chosen and a body that crossed into
+ * another region takes up that region's rate.
+ *
+ * Each engine owns the FrameArena its step-local buffers live in and resets
+ * it at the start of its own step. An engine with a thread pool is the
+ * primary engine: it splits each phase across the pool and reports step
+ * boundaries to the Profiler, which profiles one step at a time. Engines
+ * without a pool (e.g. ensemble workers, many per process) run serially.
+ */
+class Engine {
+public:
+    explicit Engine(const EngineSettings& settings = EngineSettings(), ThreadPool* pool = nullptr);
+
+    void step(World& world);
+    void run(World& world, size_t steps);
+
+    const EngineSettings& getSettings() const { return settings; }
+    EngineSettings& getSettings() { return settings; }
+    ThreadPool* getThreadPool() const { return pool; }
+
+    const StepCounters& getLastCounters() const { return counters; }
+    // Body integrations in the last step: the body count when single-rate,
+    // one per body substep when multi-rate (sleeping bodies included)
+    size_t getLastBodyUpdates() const { return bodyUpdates; }
+    // Heap allocations made during the last step, by any thread; always 0 unless
+    // built with ARCHIMEDES3D_COUNT_ALLOCATIONS. Steady-state steps should make none
+    uint64_t getLastHeapAllocations() const { return heapAllocations; }
+
+private:
+    static constexpr size_t kBodyGrain = 4096;   // Bodies per parallel chunk
+    static constexpr uint8_t kMaxLevel = 7;
+
+    // Integration of every awake body; both return the strays left for rebasing
+    size_t integrateSingleRate(World& world, float* mediumDensities);
+    // Subcycled; falls back to single-rate when every region is at level 0
+    size_t integrateMultiRate(World& world, float* mediumDensities);
+
+    template <typename Function>
+    void forEachBody(size_t count, Function&& function) {
+        if (pool) {
+            pool->parallelFor(count, kBodyGrain, function);
+        } else {
+            function(size_t(0), count);
+        }
+    }
+
+    // function(chunk) for every chunk index in [0, chunkCount), across the pool if there is one
+    template <typename Function>
+    void forEachChunk(size_t chunkCount, Function&& function) {
+        auto run = [&](size_t begin, size_t end) {
+            for (size_t chunk = begin; chunk < end; ++chunk) function(chunk);
+        };
+        if (pool) {
+            pool->parallelFor(chunkCount, 1, run);
+        } else {
+            run(size_t(0), chunkCount);
+        }
+    }
+
+    EngineSettings settings;
+    ThreadPool* pool;
+    StepCounters counters;
+    size_t bodyUpdates = 0;
+    uint64_t heapAllocations = 0;
+    FrameArena frameArena;
+};
+
+} // namespace archimedes3d
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "engine.h"
+#include "world.h"
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace archimedes3d {
+
+// Forward declarations
+class ThreadPool;
+
+/**
+ * Streaming reducer: count, mean, variance (Welford), min and max
+ */
+class RunningStatistics {
+public:
+    void add(double value);
+    void merge(const RunningStatistics& other);
+
+    size_t getCount() const { return count; }
+    double getMean() const { return mean; }
+    double getVariance() const { return count > 1 ? m2 / double(count - 1) : 0.0; }
+    double getStandardDeviation() const;
+    double getMin() const { return min; }
+    double getMax() const { return max; }
+
+private:
+    size_t count = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+};
+
+/**
+ * Aggregated outcome of an ensemble
+ */
+struct EnsembleResult {
+    std::vector<RunningStatistics> metrics;   // One reducer per metric
+    size_t runs = 0;
+    double seconds = 0.0;
+    double runsPerSecondPerCore = 0.0;
+};
+
+/**
+ * Monte Carlo runner: many independent copies of one prototype World,
+ * each perturbed, stepped and measured, spread over a thread pool.
+ *
+ * Every run starts from a copy of the prototype's body state while the
+ * material table, atmosphere and medium grid stay shared; a run that edits
+ * them gets a private copy (copy-on-write). Runs are reduced into
+ * RunningStatistics as they finish, so memory does not grow with the run
+ * count. Each run's random stream depends only on the seed and run index,
+ * and partial results merge in a fixed order, so results are reproducible
+ * for any thread count.
+ */
+class Ensemble {
+public:
+    // Perturb the fresh copy of the prototype for one run
+    using Setup = std::function<void(World& world, uint64_t runIndex, std::mt19937_64& random)>;
+    // Write metricCount values describing a finished run
+    using Measure = std::function<void(const World& world, double* metrics)>;
+
+    Ensemble(const World& prototype, const EngineSettings& settings, ThreadPool& pool);
+
+    EnsembleResult run(size_t runCount, size_t stepsPerRun, size_t metricCount,
+                       const Setup& setup, const Measure& measure, uint64_t seed = 0);
+
+private:
+    static constexpr size_t kRunsPerChunk = 8;
+
+    World prototype;
+    EngineSettings settings;
+    ThreadPool& pool;
+};
+
+} // namespace archimedes3d
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+// Set ARCHIMEDES3D_COUNT_ALLOCATIONS to 1 (debug builds) to replace the global
+// operator new with one that counts heap allocations; see HeapAllocations.
+#ifndef ARCHIMEDES3D_COUNT_ALLOCATIONS
+#define ARCHIMEDES3D_COUNT_ALLOCATIONS 0
+#endif
+
+namespace archimedes3d {
+
+/**
+ * Process-wide count of heap allocations made through operator new, to check
+ * that steady-state steps allocate nothing (see Engine::getLastHeapAllocations).
+ * Always 0 unless the library is built with ARCHIMEDES3D_COUNT_ALLOCATIONS.
+ */
+class HeapAllocations {
+public:
+    static uint64_t getCount();
+};
+
+/**
+ * Linear allocator for data that lives for one Engine step.
+ *
+ * Allocation bumps a pointer; nothing is freed individually. Each Engine owns
+ * one arena and resets it at the start of its own step, so engines stepping
+ * on other threads (or interleaved on one) never reset memory still in use.
+ * Each reset starts a new frame. If a frame outgrows the arena, extra blocks
+ * are chained and, on the next reset, merged into a single block sized to the
+ * peak, so steady-state frames take no new blocks from the heap.
+ */
+class FrameArena {
+public:
+    static constexpr size_t kDefaultCapacity = size_t(1) << 20;   // 1 MiB
+
+    explicit FrameArena(size_t initialCapacity = kDefaultCapacity);
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // Bump allocation; alignment must be a power of two
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+        const uintptr_t top = reinterpret_cast<uintptr_t>(base) + offset;
+        const uintptr_t aligned = (top + alignment - 1) & ~uintptr_t(alignment - 1);
+        const size_t end = offset + (aligned - top) + bytes;
+        if (end > capacity) {
+            return allocateSlow(bytes, alignment);
+        }
+        offset = end;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    // Only the most recent allocation of the current frame is reclaimed;
+    // everything else waits for reset
+    void deallocate(void* pointer, size_t bytes, uint64_t allocationFrame) {
+        std::byte* begin = static_cast<std::byte*>(pointer);
+        if (allocationFrame == frame && begin >= base && begin + bytes == base + offset) {
+            offset -= bytes;
+        }
+    }
+
+    // Release everything allocated since the last reset and start a new frame
+    void reset();
+
+    uint64_t getFrame() const { return frame; }
+    size_t getUsedBytes() const { return retiredBytes + offset; }
+    size_t getCapacity() const { return capacity + retiredBytes; }
+    size_t getPeakBytes() const { return peakBytes; }
+
+    // Blocks this arena took from the heap, in total and since the last reset.
+    // Other heap allocations are counted by HeapAllocations.
+    uint64_t getBlockAllocationCount() const { return blockAllocations; }
+    uint64_t getBlockAllocationsThisFrame() const { return blockAllocations - blockAllocationsAtReset; }
+
+private:
+    void* allocateSlow(size_t bytes, size_t alignment);
+    void addBlock(size_t size);
+
+    std::vector<std::unique_ptr<std::byte[]>> retired;   // Full blocks of this frame
+    std::unique_ptr<std::byte[]> block;
+    std::byte* base;
+    size_t capacity;
+    size_t offset;
+    size_t retiredBytes;
+    size_t peakBytes;
+    uint64_t frame;
+    uint64_t blockAllocations;
+    uint64_t blockAllocationsAtReset;
+};
+
+/**
+ * Standard allocator adapter over a FrameArena. It remembers the frame it was
+ * created in, so memory handed back after a reset is never reclaimed twice.
+ * Implicitly constructible from an arena: FrameVector<T> values(count, arena).
+ */
+template <typename T>
+class FrameAllocator {
+public:
+    using value_type = T;
+
+    FrameAllocator(FrameArena& arena) noexcept : arena(&arena), frame(arena.getFrame()) {}
+
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U>& other) noexcept : arena(other.getArena()), frame(other.getFrame()) {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(arena->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* pointer, size_t count) noexcept {
+        arena->deallocate(pointer, count * sizeof(T), frame);
+    }
+
+    FrameArena* getArena() const noexcept { return arena; }
+    uint64_t getFrame() const noexcept { return frame; }
+
+    template <typename U>
+    bool operator==(const FrameAllocator<U>& other) const noexcept { return arena == other.getArena(); }
+
+    template <typename U>
+    bool operator!=(const FrameAllocator<U>& other) const noexcept { return arena != other.getArena(); }
+
+private:
+    FrameArena* arena;
+    uint64_t frame;
+};
+
+// Transient containers; must not outlive the step they were created in
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+} // namespace archimedes3d
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "world.h"
+#include "../../physics/include/collision.h"
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace archimedes3d {
+
+// Forward declarations
+class ThreadPool;
+
+/**
+ * Frozen copy of the body state a batch of queries runs against.
+ *
+ * Capturing resolves world-space positions from the World's floating origins,
+ * copies radii and materials, samples the medium around every body and
+ * rebuilds the broadphase, all into buffers reused from the previous capture.
+ * Queries then read only the snapshot, so they can run on other threads while
+ * the engine steps the live World.
+ */
+class WorldSnapshot {
+public:
+    void capture(const World& world, ThreadPool& pool);
+
+    double getTime() const { return time; }
+    uint64_t getStepCount() const { return stepCount; }
+
+    size_t getBodyCount() const { return positions.size(); }
+    const Vector3* getPositions() const { return positions.data(); }
+    const double* getRadii() const { return radii.data(); }
+    const MaterialId* getMaterialIds() const { return materialIds.data(); }
+    const MaterialId* getMedia() const { return media.data(); }   // Medium at each body's centre
+
+    const BroadPhase& getBroadPhase() const { return broadPhase; }
+
+    // Bodies whose centre lies in the given medium, ascending ids
+    const BodyId* getBodiesInMedium(MaterialId medium, size_t& count) const;
+
+private:
+    double time = 0.0;
+    uint64_t stepCount = 0;
+
+    std::vector<Vector3> positions;
+    std::vector<double> radii;
+    std::vector<MaterialId> materialIds;
+    std::vector<MaterialId> media;
+
+    // Bodies grouped by medium: mediumBodies[mediumStart[m] .. mediumStart[m + 1])
+    std::vector<uint32_t> mediumStart;
+    std::vector<BodyId> mediumBodies;
+
+    BroadPhase broadPhase;
+};
+
+/**
+ * First body along a ray
+ */
+struct RayQuery {
+    Vector3 origin;
+    Vector3 direction;   // Need not be normalised
+    double maxDistance = std::numeric_limits<double>::infinity();
+};
+
+struct RayHit {
+    BodyId body = kInvalidBody;   // kInvalidBody on a miss
+    double distance = 0.0;        // m along the normalised direction
+    Vector3 point;
+    Vector3 normal;
+};
+
+/**
+ * Bodies whose bounding sphere overlaps a box, optionally only those in one medium
+ */
+struct RegionQuery {
+    Vector3 min;
+    Vector3 max;
+    MaterialId medium = kInvalidMaterial;   // kInvalidMaterial = any medium
+};
+
+/**
+ * Preallocated output of a region batch: a fixed-size slice per query, so
+ * queries fill their results in parallel without allocating or locking
+ */
+class QueryResults {
+public:
+    // Size for up to queryCount queries of capacity bodies each; reuses memory
+    void reserve(size_t queryCount, size_t capacity);
+
+    size_t getCapacity() const { return capacity; }
+    size_t getQueryCount() const { return counts.size(); }
+
+    // Bodies stored for a query (at most capacity); getTotal() counts every match
+    size_t getCount(size_t query) const { return std::min<size_t>(counts[query], capacity); }
+    size_t getTotal(size_t query) const { return counts[query]; }
+    bool isTruncated(size_t query) const { return counts[query] > capacity; }
+    const BodyId* getBodies(size_t query) const { return &bodies[query * capacity]; }
+
+private:
+    friend class SpatialQueries;
+
+    size_t capacity = 0;
+    std::vector<uint32_t> counts;
+    std::vector<BodyId> bodies;
+};
+
+/**
+ * Batched spatial queries over a WorldSnapshot.
+ *
+ * Each batch is split across the pool. A batch and an Engine step sharing
+ * one pool never run side by side: whichever parallelFor starts second runs
+ * serially on its own thread (see ThreadPool::parallelFor), so an overlapping
+ * batch either runs serially or makes the step's phases serial. Batches that
+ * overlap steps should therefore get a pool of their own, such as the one the
+ * threadCount constructor creates.
+ */
+class SpatialQueries {
+public:
+    // Batches on the caller's pool, e.g. the Engine's when they run between steps
+    explicit SpatialQueries(ThreadPool& pool);
+    // Batches on a pool owned by this object (0 threads: one per core)
+    explicit SpatialQueries(size_t threadCount);
+    ~SpatialQueries();
+
+    void raycast(const WorldSnapshot& snapshot, const RayQuery* rays, size_t count, RayHit* hits) const;
+
+    // Results must already be reserved for count queries
+    void overlap(const WorldSnapshot& snapshot, const RegionQuery* regions, size_t count,
+                 QueryResults& results) const;
+
+private:
+    static constexpr size_t kQueryGrain = 64;   // Queries per parallel chunk
+
+    std::unique_ptr<ThreadPool> ownedPool;   // Set by the threadCount constructor
+    ThreadPool& pool;
+};
+
+} // namespace archimedes3d
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "world.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace archimedes3d {
+
+// Forward declarations
+class ThreadPool;
+
+/**
+ * Geometry shared by every instance of an array. Spheres stand for balls and
+ * balloon envelopes, boxes for bricks and boat hulls; a World body gets the
+ * shape's volume and bounding radius.
+ */
+struct SceneShape {
+    enum class Kind : uint32_t {
+        Sphere = 0,   // size.x is the radius
+        Box = 1       // size is the full extent along x, y and z
+    };
+
+    Kind kind = Kind::Sphere;
+    Vector3 size;   // m
+
+    static SceneShape sphere(double radius) { return {Kind::Sphere, Vector3(radius, 0.0, 0.0)}; }
+    static SceneShape box(const Vector3& extents) { return {Kind::Box, extents}; }
+
+    double getVolume() const;
+    double getBoundingRadius() const;
+};
+
+/**
+ * Instanced array: many bodies sharing one shape and one material reference
+ */
+struct SceneArray {
+    enum class Layout : uint32_t {
+        Explicit = 0,   // One stored position (and optionally velocity) per instance
+        Grid = 1        // gridSize[0]·[1]·[2] instances at origin + spacing·(i, j, k), i fastest
+    };
+
+    uint32_t shape = 0;      // Index returned by SceneWriter::addShape
+    uint32_t material = 0;   // Index returned by SceneWriter::addMaterial
+    Layout layout = Layout::Explicit;
+
+    std::vector<Vector3> positions;     // Explicit, m
+    std::vector<Vector3f> velocities;   // Explicit; empty gives every instance `velocity`
+
+    Vector3 origin;                     // Grid, m
+    Vector3 spacing;                    // Grid, m
+    uint32_t gridSize[3] = {0, 0, 0};
+
+    Vector3f velocity;                  // m/s, shared unless per-instance velocities are stored
+
+    size_t getCount() const;
+};
+
+/**
+ * Builds a binary scene file.
+ *
+ * Layout, little-endian, no padding:
+ *   header     "A3DS", u32 version, u32 shapes, u32 materials, u32 arrays, u32 0, u64 bodies
+ *   shapes     u32 kind, u32 0, f64 size[3]
+ *   materials  u32 length, name bytes (resolved by name against the World's table)
+ *   arrays     u32 shape, u32 material, u32 layout, u32 flags, u64 count,
+ *              f64 origin[3], f64 spacing[3], u32 gridSize[3], f32 velocity[3],
+ *              then for explicit arrays f64 position[3] per instance and,
+ *              with flag 1, f32 velocity[3] per instance
+ */
+class SceneWriter {
+public:
+    uint32_t addShape(const SceneShape& shape);
+    uint32_t addMaterial(const std::string& name);   // Reuses the index of a name added before
+    // False (and nothing is added) if per-instance velocities do not match the positions
+    bool addArray(SceneArray array);
+
+    size_t getBodyCount() const;
+
+    std::vector<uint8_t> serialize() const;
+    bool write(const std::string& path) const;
+
+private:
+    std::vector<SceneShape> shapes;
+    std::vector<std::string> materials;
+    std::vector<SceneArray> arrays;
+};
+
+/**
+ * Reads a binary scene straight into a World's component arrays.
+ *
+ * The header, shapes, material names, array headers and instance data are
+ * validated first, so a malformed file leaves the world untouched. All bodies
+ * are then appended in one go and filled in parallel over the thread pool:
+ * each chunk decodes its instances and writes volumes, radii, densities,
+ * materials, velocities, region-local positions and temperatures in place.
+ * Regions can only be created serially, so the parallel pass that checks
+ * instance data also collects the distinct regions the bodies fall in, and
+ * they are opened before the bodies are placed.
+ */
+class SceneLoader {
+public:
+    static constexpr uint32_t kVersion = 1;
+
+    explicit SceneLoader(ThreadPool* pool = nullptr);
+
+    // Append the scene's bodies to world; false (see getError) on failure
+    bool load(const std::string& path, World& world);
+    bool parse(const uint8_t* data, size_t size, World& world);
+
+    const std::string& getError() const { return error; }
+
+    // Bodies added by the last successful load: [getFirstBody(), getFirstBody() + getBodyCount())
+    BodyId getFirstBody() const { return firstBody; }
+    size_t getBodyCount() const { return bodyCount; }
+
+private:
+    static constexpr size_t kLoadGrain = 16384;   // Bodies per parallel chunk
+
+    // An array header resolved against the world, with the offset of its instance data
+    struct ParsedArray {
+        size_t firstBody;
+        size_t count;
+        SceneArray::Layout layout;
+        double volume;
+        double radius;
+        MaterialId material;
+        double density;
+        Vector3 origin;
+        Vector3 spacing;
+        uint32_t gridSize[3];
+        Vector3f velocity;
+        const uint8_t* positions;    // Explicit only
+        const uint8_t* velocities;   // Explicit with per-instance velocities only
+    };
+
+    static Vector3 decodePosition(const ParsedArray& array, size_t index);
+    bool fail(const std::string& message);
+
+    template <typename Function>
+    void forEachBody(size_t count, Function&& function);
+
+    ThreadPool* pool;
+    std::vector<ParsedArray> parsed;
+    std::string error;
+    BodyId firstBody = 0;
+    size_t bodyCount = 0;
+};
+
+} // namespace archimedes3d
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace archimedes3d {
+
+/**
+ * Fixed set of worker threads shared by the engine's parallel phases.
+ *
+ * parallelFor splits [0, count) into chunks and runs them on the workers and
+ * the calling thread. It does not allocate, so it is safe inside Engine::step.
+ * A parallelFor issued while another one is running (nested, or from a second
+ * thread) runs inline on its caller instead of waiting for workers.
+ */
+class ThreadPool {
+public:
+    // threadCount includes the calling thread; 0 uses hardware concurrency
+    explicit ThreadPool(size_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t getThreadCount() const { return workers.size() + 1; }
+
+    // function(begin, end) is invoked for disjoint ranges covering [0, count)
+    template <typename Function>
+    void parallelFor(size_t count, size_t grain, Function&& function) {
+        if (count == 0) return;
+        auto invoke = [](void* context, size_t begin, size_t end) {
+            (*static_cast<std::remove_reference_t<Function>*>(context))(begin, end);
+        };
+        run(count, grain == 0 ? 1 : grain, invoke, &function);
+    }
+
+    // Fire-and-forget task on a worker (allocates; not for per-step hot paths)
+    std::future<void> submit(std::function<void()> task);
+
+    // Process-wide pool sized to the machine
+    static ThreadPool& shared();
+
+private:
+    using ChunkFunction = void (*)(void* context, size_t begin, size_t end);
+
+    struct Job {
+        ChunkFunction function;
+        void* context;
+        size_t count;
+        size_t grain;
+        std::atomic<size_t> next{0};
+        size_t participants = 0;   // Workers inside runChunks, guarded by mutex
+    };
+
+    void run(size_t count, size_t grain, ChunkFunction function, void* context);
+    static void runChunks(Job& job);
+    void workerLoop();
+
+    std::vector<std::thread> workers;
+    std::deque<std::packaged_task<void()>> tasks;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable jobDone;
+
+    Job* activeJob = nullptr;
+    uint64_t jobGeneration = 0;
+    bool stopping = false;
+};
+
+} // namespace archimedes3d
@@ -0,0 +1,210 @@
+#pragma once
+
+#include "../../environment/include/atmosphere.h"
+#include "../../materials/include/material_table.h"
+#include "../../math/include/vectors.h"
+#include "../../mediums/include/mediums.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace archimedes3d {
+
+using BodyId = uint32_t;
+constexpr BodyId kInvalidBody = 0xffffffff;
+
+/**
+ * Read-only data a World is built on. Many worlds may share one environment;
+ * each World copies a part only when it edits it.
+ */
+struct WorldEnvironment {
+    std::shared_ptr<const MaterialTable> materials;
+    std::shared_ptr<const Atmosphere> atmosphere;   // Optional: scales gas media with altitude
+    std::shared_ptr<const MediumGrid> medium;       // Optional: ambient medium everywhere if absent
+};
+
+/**
+ * Simulation state: bodies stored as component arrays plus the environment.
+ *
+ * Positions use a floating origin: space is cut into cubic regions, each with
+ * a double-precision origin at its centre, and a body stores its region id
+ * and a float offset from that origin, so positions keep a resolution of
+ * about 15 µm however far the body is from the world origin. A body keeps its
+ * region until it strays more than kRegionReach from the origin;
+ * rebaseBodies() then moves it to the region it is in.
+ *
+ * Everything the integration kernels touch is float and stored as one stream
+ * per axis (offsets, velocities, forces) or per quantity (volumes, radii,
+ * densities), so they read half the bytes of double vectors and vectorise
+ * across bodies.
+ *
+ * Copying a World copies the per-run body state and shares the environment,
+ * which is what ensemble runs rely on.
+ */
+class World {
+public:
+    static constexpr double kRegionSize = 256.0;                       // m, edge of a region
+    static constexpr float kRegionReach = float(0.75 * kRegionSize);   // m, largest offset before a rebase
+    static constexpr uint32_t kNoRegion = 0xffffffff;                  // Body not placed yet
+
+    explicit World(WorldEnvironment environment);
+
+    // Shared environment
+    const WorldEnvironment& getEnvironment() const { return environment; }
+    const MaterialTable& getMaterials() const { return *environment.materials; }
+    const Atmosphere* getAtmosphere() const { return environment.atmosphere.get(); }
+    const MediumGrid* getMedium() const { return environment.medium.get(); }
+    MaterialId getAmbientMedium() const { return ambientMedium; }
+
+    // Copy-on-write access; the first edit detaches this world from shared data.
+    // Call refreshDensities() after changing material densities. Like
+    // getMedium(), editMedium() is null for a world without a medium grid
+    MaterialTable& editMaterials();
+    MediumGrid* editMedium();
+
+    // Medium material and density at a point (gases thin out with altitude)
+    MaterialId sampleMedium(const Vector3& position) const {
+        return environment.medium ? environment.medium->sample(position) : ambientMedium;
+    }
+    double sampleMediumDensity(const Vector3& position) const;
+    double sampleMediumTemperature(const Vector3& position) const;   // K
+
+    // Body creation
+    BodyId addBody(const Vector3& position, double volume, double radius, MaterialId material,
+                   const Vector3& velocity = Vector3());
+    BodyId addSphere(const Vector3& position, double radius, MaterialId material,
+                     const Vector3& velocity = Vector3());
+    void reserveBodies(size_t count);
+    void clearBodies();
+
+    // Bulk creation for loaders: appends count empty bodies (no region, zero
+    // volume) and returns the first id. Fill them through placeBody() and the
+    // component arrays; disjoint ranges may be filled concurrently
+    BodyId addBodies(size_t count);
+
+    size_t getBodyCount() const { return regionIds.size(); }
+
+    // Per-body access
+    Vector3 getPosition(BodyId id) const {
+        return regionOrigins[regionIds[id]] + Vector3(getLocalPositions().load(id));
+    }
+    void setPosition(BodyId id, const Vector3& value);
+    // Set the position without waking. Without createRegion only existing
+    // regions are used (safe to run concurrently); returns false and leaves
+    // the body at kNoRegion if its region does not exist yet
+    bool placeBody(BodyId id, const Vector3& position, bool createRegion);
+
+    Vector3 getVelocity(BodyId id) const { return Vector3(getVelocities().load(id)); }
+    void setVelocity(BodyId id, const Vector3& value) {
+        getVelocities().store(id, Vector3f(value));
+        wake(id);
+    }
+
+    double getVolume(BodyId id) const { return volumes[id]; }
+    double getRadius(BodyId id) const { return radii[id]; }
+    double getDensity(BodyId id) const { return densities[id]; }
+    double getMass(BodyId id) const { return double(densities[id]) * volumes[id]; }
+
+    MaterialId getMaterial(BodyId id) const { return materialIds[id]; }
+    // conserveMass rescales volume and radius to the new density (phase changes)
+    void setMaterial(BodyId id, MaterialId material, bool conserveMass = false);
+
+    double getTemperature(BodyId id) const { return temperatures[id]; }
+    void setTemperature(BodyId id, double value) { temperatures[id] = value; }
+
+    void applyForce(BodyId id, const Vector3& force);
+    void applyImpulse(BodyId id, const Vector3& impulse);
+
+    bool isSleeping(BodyId id) const { return sleeping[id] != 0; }
+    void wake(BodyId id) { sleeping[id] = 0; sleepCounters[id] = 0; }
+    void wakeAll();
+
+    // Component arrays for engine kernels; a body's world position is
+    // getRegionOrigins()[regionIds[i]] + getLocalPositions().load(i)
+    Vector3Streams<float> getLocalPositions() { return {positionX.data(), positionY.data(), positionZ.data()}; }
+    Vector3Streams<float> getVelocities() { return {velocityX.data(), velocityY.data(), velocityZ.data()}; }
+    Vector3Streams<float> getForces() { return {forceX.data(), forceY.data(), forceZ.data()}; }
+    Vector3Streams<const float> getLocalPositions() const {
+        return {positionX.data(), positionY.data(), positionZ.data()};
+    }
+    const uint32_t* getRegionIds() const { return regionIds.data(); }
+    const Vector3* getRegionOrigins() const { return regionOrigins.data(); }
+    const float* getRegionHeights() const { return regionHeights.data(); }
+    Vector3Streams<const float> getVelocities() const {
+        return {velocityX.data(), velocityY.data(), velocityZ.data()};
+    }
+    Vector3Streams<const float> getForces() const { return {forceX.data(), forceY.data(), forceZ.data()}; }
+    float* getVolumes() { return volumes.data(); }
+    float* getRadii() { return radii.data(); }
+    float* getDensities() { return densities.data(); }
+    MaterialId* getMaterialIds() { return materialIds.data(); }
+    double* getTemperatures() { return temperatures.data(); }
+    const float* getVolumes() const { return volumes.data(); }
+    const float* getRadii() const { return radii.data(); }
+    const float* getDensities() const { return densities.data(); }
+    const MaterialId* getMaterialIds() const { return materialIds.data(); }
+    const double* getTemperatures() const { return temperatures.data(); }
+    uint8_t* getSleeping() { return sleeping.data(); }
+    const uint8_t* getSleeping() const { return sleeping.data(); }
+    uint16_t* getSleepCounters() { return sleepCounters.data(); }
+
+    // Re-read every body's density from the material table
+    void refreshDensities();
+
+    // Regions
+    size_t getRegionCount() const { return regionOrigins.size(); }
+    // Whether position lies in the space regions cover: finite and within
+    // 2^20 regions (about 268,000 km) of the origin on every axis
+    static bool isPlaceable(const Vector3& position);
+    // Key of the region containing a placeable position; equal keys share a region
+    static uint64_t regionKey(const Vector3& position);
+    // Create the region containing position if it does not exist yet and return it
+    uint32_t openRegion(const Vector3& position) { return findRegion(position, true); }
+    static bool isStray(float x, float y, float z) {
+        // Branch-free: this runs for every body in the integration loop
+        return std::max(std::max(std::abs(x), std::abs(y)), std::abs(z)) > kRegionReach;
+    }
+    // Move stray bodies in [begin, end) to the region containing them and
+    // return how many are left. Without createRegions only existing regions
+    // are used, so disjoint ranges may be rebased concurrently
+    size_t rebaseBodies(size_t begin, size_t end, bool createRegions);
+
+    // Clock
+    double getTime() const { return time; }
+    uint64_t getStepCount() const { return stepCount; }
+    void advanceClock(double dt) { time += dt; ++stepCount; }
+
+private:
+    // Region containing position, or kNoRegion if it does not exist and create
+    // is false (a pure lookup, safe to run concurrently)
+    uint32_t findRegion(const Vector3& position, bool create);
+
+    WorldEnvironment environment;
+    MaterialId ambientMedium;
+
+    // Floating origins, one per occupied region
+    std::vector<Vector3> regionOrigins;
+    std::vector<float> regionHeights;   // Origin z per region (exact in float), for ground contact
+    std::unordered_map<uint64_t, uint32_t> regionLookup;
+
+    // Body components
+    std::vector<float> positionX, positionY, positionZ;   // m, from the region origin
+    std::vector<uint32_t> regionIds;
+    std::vector<float> velocityX, velocityY, velocityZ;   // m/s
+    std::vector<float> forceX, forceY, forceZ;            // N, external forces for the next step
+    std::vector<float> volumes;             // m³
+    std::vector<float> radii;               // m, bounding sphere
+    std::vector<float> densities;           // kg/m³, packed copy of the material density
+    std::vector<MaterialId> materialIds;
+    std::vector<double> temperatures;       // K, starts at the surrounding medium's
+    std::vector<uint8_t> sleeping;
+    std::vector<uint16_t> sleepCounters;    // Consecutive slow steps
+
+    double time;
+    uint64_t stepCount;
+};
+
+} // namespace archimedes3d
@@ -0,0 +1,261 @@
+#include "../include/engine.h"
+#include "../include/world.h"
+#include "../../physics/include/buoyancy.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace archimedes3d {
+
+namespace {
+
+constexpr double kContactTolerance = 1.0e-3;   // m above the ground that still counts as touching it
+
+// Smallest level whose substep brings a ratio (what one coarse step would take
+// over what a substep may take) to at most 1, given the ratio squared
+uint8_t levelFor(double ratioSquared, uint8_t maxLevel) {
+    uint8_t level = 0;
+    while (ratioSquared > 1.0 && level < maxLevel) {
+        ratioSquared *= 0.25;
+        ++level;
+    }
+    return level;
+}
+
+} // namespace
+
+Engine::Engine(const EngineSettings& settings, ThreadPool* pool)
+    : settings(settings)
+    , pool(pool)
+{
+}
+
+void Engine::step(World& world) {
+    const uint64_t allocationsBefore = HeapAllocations::getCount();
+    const bool profiled = pool != nullptr && ARCHIMEDES3D_PROFILE_BEGIN_STEP(world.getStepCount());
+    frameArena.reset();
+
+    const double dt = settings.timeStep;
+    const size_t count = world.getBodyCount();
+    FrameVector<float> mediumDensities(count, frameArena);
+
+    {
+        ARCHIMEDES3D_PROFILE_SCOPE("medium");
+        forEachBody(count, [&](size_t begin, size_t end) {
+            Buoyancy::sampleMedium(world, begin, end, mediumDensities.data());
+        });
+    }
+
+    const bool multiRate = settings.multiRate.enabled && settings.multiRate.maxLevel > 0;
+    const size_t strays = multiRate ? integrateMultiRate(world, mediumDensities.data())
+                                    : integrateSingleRate(world, mediumDensities.data());
+
+    if (strays > 0) {
+        // Only bodies entering a region no body has used yet get here
+        ARCHIMEDES3D_PROFILE_SCOPE("rebase");
+        world.rebaseBodies(0, count, true);
+    }
+
+    std::atomic<size_t> asleep{0};
+    {
+        ARCHIMEDES3D_PROFILE_SCOPE("sleep");
+        forEachBody(count, [&](size_t begin, size_t end) {
+            asleep.fetch_add(Motion::updateSleeping(world, begin, end, settings.motion), std::memory_order_relaxed);
+        });
+    }
+
+    world.advanceClock(dt);
+
+    counters.sleepingBodies = asleep.load();
+    counters.bodiesProcessed = count - counters.sleepingBodies;
+    counters.contactPairs = 0;
+    heapAllocations = HeapAllocations::getCount() - allocationsBefore;
+
+    if (profiled) {
+        ARCHIMEDES3D_PROFILE_END_STEP(counters);
+    }
+}
+
+size_t Engine::integrateSingleRate(World& world, float* mediumDensities) {
+    ARCHIMEDES3D_PROFILE_SCOPE("integrate");
+    const size_t count = world.getBodyCount();
+    std::atomic<size_t> strays{0};
+    forEachBody(count, [&](size_t begin, size_t end) {
+        const size_t found = Motion::integrate(world, begin, end, mediumDensities, settings.timeStep,
+                                               settings.motion);
+        strays.fetch_add(found, std::memory_order_relaxed);
+    });
+    bodyUpdates = count;
+    return strays.load();
+}
+
+size_t Engine::integrateMultiRate(World& world, float* mediumDensities) {
+    const MultiRateSettings& multiRate = settings.multiRate;
+    const uint8_t maxLevel = std::min(multiRate.maxLevel, kMaxLevel);
+    const double dt = settings.timeStep;
+    const size_t count = world.getBodyCount();
+    const size_t regionCount = world.getRegionCount();
+    const uint32_t* regionIds = world.getRegionIds();
+
+    // Activity of each awake body, folded straight into its region: the level its speed and
+    // acceleration ask for, and ground impacts. A limit of zero switches its criterion off
+    auto scaleFor = [dt](double limit) { return limit > 0.0 ? dt * dt / (limit * limit) : 0.0; };
+    const double speedScale = scaleFor(multiRate.maxDisplacement);
+    const double accelerationScale = scaleFor(multiRate.maxVelocityChange);
+    const bool countContacts = multiRate.contactsPerLevel > 0;
+    FrameVector<std::atomic<uint8_t>> regionActivity(regionCount, frameArena);
+    FrameVector<std::atomic<uint32_t>> regionContacts(regionCount, frameArena);
+    {
+        ARCHIMEDES3D_PROFILE_SCOPE("activity");
+        forEachBody(count, [&](size_t begin, size_t end) {
+            const World& bodies = world;
+            const Vector3Streams<const float> positions = bodies.getLocalPositions();
+            const Vector3Streams<const float> velocities = bodies.getVelocities();
+            const Vector3Streams<const float> forces = bodies.getForces();
+            const Vector3* origins = bodies.getRegionOrigins();
+            const float* volumes = bodies.getVolumes();
+            const float* densities = bodies.getDensities();
+            const float* radii = bodies.getRadii();
+            const uint8_t* sleeping = bodies.getSleeping();
+
+            for (size_t i = begin; i < end; ++i) {
+                if (sleeping[i]) continue;
+
+                const double volume = volumes[i];
+                const double density = densities[i];
+                const double lift = Buoyancy::calculateNetForce(double(mediumDensities[i]), density, volume,
+                                                                settings.motion.gravity);
+                const double mass = density * volume;
+                const Vector3 acceleration = (Vector3(forces.load(i)) + Vector3(0.0, 0.0, lift)) / mass;
+                const Vector3 velocity(velocities.load(i));
+                const double ratioSquared = std::max(velocity.lengthSquared() * speedScale,
+                                                     acceleration.lengthSquared() * accelerationScale);
+                const uint8_t level = levelFor(ratioSquared, maxLevel);
+
+                // Most bodies leave their region's level as it is, so the read usually spares the write
+                std::atomic<uint8_t>& regionLevel = regionActivity[regionIds[i]];
+                uint8_t seen = regionLevel.load(std::memory_order_relaxed);
+                while (level > seen
+                       && !regionLevel.compare_exchange_weak(seen, level, std::memory_order_relaxed)) {
+                }
+
+                // Resting contact jitters by about g·dt; only impacts faster than a substep may change count
+                const double height = origins[regionIds[i]].z + positions.z[i];
+                if (countContacts && height <= settings.motion.groundHeight + radii[i] + kContactTolerance
+                    && velocities.z[i] < -multiRate.maxVelocityChange) {
+                    regionContacts[regionIds[i]].fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    // Region levels: the most active body, raised by the number of impacts
+    FrameVector<uint8_t> regionLevels(regionCount, frameArena);
+    uint8_t finest = 0;   // Finest level any region asked for
+    for (size_t region = 0; region < regionCount; ++region) {
+        // Each doubling of the impact count asks for one finer level
+        uint8_t level = 0;
+        if (countContacts) {
+            const uint32_t impacts = regionContacts[region].load(std::memory_order_relaxed);
+            for (uint32_t doublings = impacts / multiRate.contactsPerLevel; doublings > 0; doublings >>= 1) {
+                ++level;
+            }
+        }
+        regionLevels[region] = std::max(regionActivity[region].load(std::memory_order_relaxed),
+                                        std::min(level, maxLevel));
+        finest = std::max(finest, regionLevels[region]);
+    }
+
+    // A calm world needs no ordering or substeps
+    if (finest == 0) return integrateSingleRate(world, mediumDensities);
+
+    // Bodies ordered by level, finest first, so the bodies due at any substep form a prefix.
+    // A counting sort over fixed chunks: per-chunk histograms, then each chunk scatters its bodies
+    const size_t chunkCount = (count + kBodyGrain - 1) / kBodyGrain;
+    FrameVector<size_t> chunkCursors(chunkCount * (finest + 1), frameArena);
+    auto chunkCursor = [&](size_t chunk, uint8_t level) -> size_t& {
+        return chunkCursors[chunk * (finest + 1) + level];
+    };
+    FrameVector<BodyId> order(count, frameArena);
+    size_t levelEnd[kMaxLevel + 1] = {};   // Level l ends at order[levelEnd[l]] and starts where level l + 1 ends
+    {
+        ARCHIMEDES3D_PROFILE_SCOPE("levels");
+        forEachChunk(chunkCount, [&](size_t chunk) {
+            const size_t end = std::min(count, (chunk + 1) * kBodyGrain);
+            for (size_t i = chunk * kBodyGrain; i < end; ++i) ++chunkCursor(chunk, regionLevels[regionIds[i]]);
+        });
+
+        // Exclusive prefix in level-major, chunk-minor order keeps each level in body order
+        size_t offset = 0;
+        for (int level = finest; level >= 0; --level) {
+            for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+                const size_t bodies = chunkCursor(chunk, static_cast<uint8_t>(level));
+                chunkCursor(chunk, static_cast<uint8_t>(level)) = offset;
+                offset += bodies;
+            }
+            levelEnd[level] = offset;
+        }
+
+        forEachChunk(chunkCount, [&](size_t chunk) {
+            const size_t end = std::min(count, (chunk + 1) * kBodyGrain);
+            for (size_t i = chunk * kBodyGrain; i < end; ++i) {
+                order[chunkCursor(chunk, regionLevels[regionIds[i]])++] = static_cast<BodyId>(i);
+            }
+        });
+    }
+    auto levelBegin = [&](uint8_t level) { return level == finest ? size_t(0) : levelEnd[level + 1]; };
+
+    // Fine ticks: a level-l body is due every 2^(finest - l) ticks and advances dt / 2^l
+    std::atomic<size_t> strays{0};
+    bodyUpdates = 0;
+    {
+        ARCHIMEDES3D_PROFILE_SCOPE("integrate");
+        const uint32_t ticks = 1u << finest;
+        for (uint32_t tick = 0; tick < ticks; ++tick) {
+            uint8_t coarsest = 0;   // Coarsest level due at this tick
+            if (tick > 0) {
+                uint32_t trailing = 0;
+                while (((tick >> trailing) & 1u) == 0) ++trailing;
+                coarsest = static_cast<uint8_t>(finest - trailing);
+            }
+            const size_t due = levelEnd[coarsest];
+            if (due == 0) continue;
+
+            if (tick > 0) {
+                forEachBody(due, [&](size_t begin, size_t end) {
+                    Buoyancy::sampleMediumList(world, order.data() + begin, end - begin, mediumDensities);
+                });
+            }
+            forEachBody(due, [&](size_t begin, size_t end) {
+                size_t found = 0;
+                for (int level = finest; level >= coarsest; --level) {
+                    const size_t from = std::max(begin, levelBegin(static_cast<uint8_t>(level)));
+                    const size_t to = std::min(end, levelEnd[level]);
+                    if (from >= to) continue;
+                    found += Motion::integrateList(world, order.data() + from, to - from, mediumDensities,
+                                                   dt / double(1u << level), settings.motion);
+                }
+                strays.fetch_add(found, std::memory_order_relaxed);
+            });
+            bodyUpdates += due;
+        }
+
+        // External forces held for the whole step are spent now
+        forEachBody(count, [&](size_t begin, size_t end) {
+            const Vector3Streams<float> forces = world.getForces();
+            for (float* axis : {forces.x, forces.y, forces.z}) {
+                std::fill(axis + begin, axis + end, 0.0f);
+            }
+        });
+    }
+
+    return strays.load();
+}
+
+void Engine::run(World& world, size_t steps) {
+    for (size_t i = 0; i < steps; ++i) {
+        step(world);
+    }
+}
+
+} // namespace archimedes3d
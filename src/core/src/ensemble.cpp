@@ -0,0 +1,104 @@
+#include "../include/ensemble.h"
+#include "../include/thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace archimedes3d {
+
+namespace {
+
+// SplitMix64: decorrelates per-run seeds derived from consecutive indices
+uint64_t mixSeed(uint64_t value) {
+    value += 0x9e3779b97f4a7c15ULL;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+} // namespace
+
+void RunningStatistics::add(double value) {
+    ++count;
+    const double delta = value - mean;
+    mean += delta / double(count);
+    m2 += delta * (value - mean);
+    min = std::min(min, value);
+    max = std::max(max, value);
+}
+
+void RunningStatistics::merge(const RunningStatistics& other) {
+    if (other.count == 0) return;
+    if (count == 0) {
+        *this = other;
+        return;
+    }
+
+    // Chan et al. parallel combination
+    const double total = double(count + other.count);
+    const double delta = other.mean - mean;
+    mean += delta * double(other.count) / total;
+    m2 += other.m2 + delta * delta * double(count) * double(other.count) / total;
+    count += other.count;
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+}
+
+double RunningStatistics::getStandardDeviation() const {
+    return std::sqrt(getVariance());
+}
+
+Ensemble::Ensemble(const World& prototype, const EngineSettings& settings, ThreadPool& pool)
+    : prototype(prototype)
+    , settings(settings)
+    , pool(pool)
+{
+}
+
+EnsembleResult Ensemble::run(size_t runCount, size_t stepsPerRun, size_t metricCount,
+                             const Setup& setup, const Measure& measure, uint64_t seed) {
+    const auto start = std::chrono::steady_clock::now();
+
+    const size_t chunkCount = (runCount + kRunsPerChunk - 1) / kRunsPerChunk;
+    std::vector<RunningStatistics> partial(chunkCount * metricCount);
+
+    pool.parallelFor(runCount, kRunsPerChunk, [&](size_t begin, size_t end) {
+        // One world and one serial engine per chunk, reused across its runs
+        World world(prototype);
+        Engine engine(settings, nullptr);
+        std::vector<double> metrics(metricCount);
+
+        for (size_t run = begin; run < end; ++run) {
+            RunningStatistics* reducers = &partial[(run / kRunsPerChunk) * metricCount];
+            world = prototype;
+            std::mt19937_64 random(mixSeed(seed ^ mixSeed(run)));
+            if (setup) setup(world, run, random);
+
+            engine.run(world, stepsPerRun);
+
+            std::fill(metrics.begin(), metrics.end(), 0.0);
+            measure(world, metrics.data());
+            for (size_t m = 0; m < metricCount; ++m) {
+                reducers[m].add(metrics[m]);
+            }
+        }
+    });
+
+    EnsembleResult result;
+    result.metrics.resize(metricCount);
+    for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+        for (size_t m = 0; m < metricCount; ++m) {
+            result.metrics[m].merge(partial[chunk * metricCount + m]);
+        }
+    }
+
+    result.runs = runCount;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (result.seconds > 0.0) {
+        result.runsPerSecondPerCore = double(runCount) / result.seconds / double(pool.getThreadCount());
+    }
+    return result;
+}
+
+} // namespace archimedes3d
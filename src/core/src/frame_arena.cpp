@@ -0,0 +1,85 @@
+#include "../include/frame_arena.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+
+#if ARCHIMEDES3D_COUNT_ALLOCATIONS
+namespace {
+
+std::atomic<uint64_t> heapAllocations{0};
+
+} // namespace
+
+// Replacements of the global allocation functions; the array and nothrow
+// forms forward to these by default
+void* operator new(size_t size) {
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size > 0 ? size : 1)) return pointer;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    std::free(pointer);
+}
+#endif
+
+namespace archimedes3d {
+
+uint64_t HeapAllocations::getCount() {
+#if ARCHIMEDES3D_COUNT_ALLOCATIONS
+    return heapAllocations.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif
+}
+
+FrameArena::FrameArena(size_t initialCapacity)
+    : base(nullptr)
+    , capacity(0)
+    , offset(0)
+    , retiredBytes(0)
+    , peakBytes(0)
+    , frame(0)
+    , blockAllocations(0)
+    , blockAllocationsAtReset(0)
+{
+    addBlock(std::max<size_t>(initialCapacity, 64));
+}
+
+void FrameArena::addBlock(size_t size) {
+    block.reset(new std::byte[size]);
+    base = block.get();
+    capacity = size;
+    offset = 0;
+    ++blockAllocations;
+}
+
+void* FrameArena::allocateSlow(size_t bytes, size_t alignment) {
+    // Retire the current block and chain a larger one; merged on reset
+    retiredBytes += capacity;
+    retired.push_back(std::move(block));
+    addBlock(std::max(capacity * 2, bytes + alignment));
+    return allocate(bytes, alignment);
+}
+
+void FrameArena::reset() {
+    peakBytes = std::max(peakBytes, getUsedBytes());
+
+    if (!retired.empty()) {
+        // Replace the chain with one block large enough for the peak frame
+        const size_t merged = retiredBytes + capacity;
+        retired.clear();
+        retiredBytes = 0;
+        addBlock(merged);
+    }
+    offset = 0;
+    ++frame;
+    blockAllocationsAtReset = blockAllocations;
+}
+
+} // namespace archimedes3d
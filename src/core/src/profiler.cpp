@@ -0,0 +1,349 @@
+#include "../include/profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace archimedes3d {
+
+namespace {
+
+constexpr size_t kRingCapacity = size_t(1) << 14;   // Events per thread (power of two)
+
+struct RawEvent {
+    const char* name;
+    uint64_t begin;
+    uint64_t end;
+};
+
+// Single-producer ring; only the owning thread advances head
+struct ThreadRing {
+    std::array<RawEvent, kRingCapacity> events;
+    std::atomic<uint64_t> head{0};
+    std::atomic<bool> retired{false};   // Set when the owning thread exits
+    uint64_t tail = 0;      // Collector position, touched only under the state mutex
+    uint32_t threadIndex = 0;
+};
+
+struct TraceEvent {
+    const char* name;
+    uint64_t begin;
+    uint64_t end;
+    uint32_t threadIndex;
+};
+
+struct CounterSample {
+    uint64_t time;
+    StepCounters counters;
+};
+
+struct ProfilerState {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadRing>> rings;
+    uint32_t nextThreadIndex = 0;
+
+    bool captureTrace = false;
+    std::vector<TraceEvent> trace;
+    std::vector<CounterSample> counterSamples;
+
+    // Step state, guarded by mutex like everything above
+    bool stepOpen = false;   // Between a granted beginStep and its endStep
+    uint64_t currentStep = 0;
+    uint64_t stepBegin = 0;
+    StepSummary lastSummary;
+
+    std::once_flag calibrated;
+    double ticksPerMillisecond = 0.0;   // Written once under calibrated, read only after it
+};
+
+ProfilerState& state() {
+    static ProfilerState instance;
+    return instance;
+}
+
+// Marks the thread's ring retired on thread exit; the collector frees it once drained
+struct RingOwner {
+    ThreadRing* ring = nullptr;
+    ~RingOwner() {
+        if (ring) ring->retired.store(true, std::memory_order_release);
+    }
+};
+
+thread_local RingOwner localRing;
+
+ThreadRing& acquireRing() {
+    ProfilerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.rings.push_back(std::make_unique<ThreadRing>());
+    ThreadRing* ring = s.rings.back().get();
+    ring->threadIndex = s.nextThreadIndex++;
+    localRing.ring = ring;
+    return *ring;
+}
+
+// Free the rings of exited threads; their events must have been drained already
+void releaseRetired(ProfilerState& s, const std::vector<bool>& drained) {
+    size_t kept = 0;
+    for (size_t i = 0; i < s.rings.size(); ++i) {
+        if (!drained[i]) s.rings[kept++] = std::move(s.rings[i]);
+    }
+    s.rings.resize(kept);
+}
+
+void appendEscaped(std::string& out, const char* text) {
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') out += '\\';
+        out += *c;
+    }
+}
+
+} // namespace
+
+std::atomic<bool> Profiler::enabled{false};
+
+uint64_t Profiler::steadyNanoseconds() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+double Profiler::ticksPerMillisecond() {
+    ProfilerState& s = state();
+    std::call_once(s.calibrated, [&s] {
+#if ARCHIMEDES3D_PROFILER_TSC
+        // Measure the TSC rate against the steady clock over ~10 ms
+        const uint64_t tickStart = timestamp();
+        const uint64_t nanoStart = steadyNanoseconds();
+        uint64_t nanoNow = nanoStart;
+        while (nanoNow - nanoStart < 10000000) {
+            nanoNow = steadyNanoseconds();
+        }
+        const uint64_t tickEnd = timestamp();
+        s.ticksPerMillisecond = double(tickEnd - tickStart) * 1.0e6 / double(nanoNow - nanoStart);
+#else
+        s.ticksPerMillisecond = 1.0e6;
+#endif
+    });
+    return s.ticksPerMillisecond;
+}
+
+void Profiler::setEnabled(bool value) {
+    if (value) {
+        ticksPerMillisecond();
+    }
+    enabled.store(value, std::memory_order_relaxed);
+}
+
+void Profiler::setTraceCapture(bool capture) {
+    ProfilerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.captureTrace = capture;
+}
+
+void Profiler::record(const char* name, uint64_t begin, uint64_t end) {
+    ThreadRing& ring = localRing.ring ? *localRing.ring : acquireRing();
+    const uint64_t head = ring.head.load(std::memory_order_relaxed);
+    ring.events[head & (kRingCapacity - 1)] = RawEvent{name, begin, end};
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+bool Profiler::beginStep(uint64_t step) {
+    if (!isEnabled()) return false;
+    ProfilerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (s.stepOpen) return false;   // Another engine's step owns the rings
+    s.stepOpen = true;
+    s.currentStep = step;
+    s.stepBegin = timestamp();
+    return true;
+}
+
+const StepSummary& Profiler::endStep(const StepCounters& counters) {
+    ProfilerState& s = state();
+    const uint64_t stepEnd = timestamp();
+    const double msPerTick = 1.0 / ticksPerMillisecond();
+
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (!s.stepOpen) {
+        return s.lastSummary;
+    }
+    s.stepOpen = false;
+
+    StepSummary summary;
+    summary.step = s.currentStep;
+    summary.totalMilliseconds = double(stepEnd - s.stepBegin) * msPerTick;
+    summary.counters = counters;
+
+    std::array<uint64_t, StepSummary::kMaxPhases> firstBegin{};
+    std::array<uint64_t, StepSummary::kMaxPhases> lastEnd{};
+
+    // The profiled step's workers have joined by now, so draining cannot race with them
+    std::vector<bool> drained(s.rings.size(), false);
+    for (size_t r = 0; r < s.rings.size(); ++r) {
+        ThreadRing* ring = s.rings[r].get();
+        drained[r] = ring->retired.load(std::memory_order_acquire);   // Before head: no later events
+        const uint64_t head = ring->head.load(std::memory_order_acquire);
+        if (head - ring->tail > kRingCapacity) {
+            summary.droppedEvents += head - ring->tail - kRingCapacity;
+            ring->tail = head - kRingCapacity;
+        }
+
+        for (uint64_t i = ring->tail; i < head; ++i) {
+            const RawEvent& event = ring->events[i & (kRingCapacity - 1)];
+
+            size_t phase = 0;
+            while (phase < summary.phaseCount &&
+                   summary.phases[phase].name != event.name &&
+                   std::strcmp(summary.phases[phase].name, event.name) != 0) {
+                ++phase;
+            }
+            if (phase == summary.phaseCount) {
+                if (phase == StepSummary::kMaxPhases) continue;
+                summary.phases[phase].name = event.name;
+                firstBegin[phase] = event.begin;
+                lastEnd[phase] = event.end;
+                ++summary.phaseCount;
+            }
+
+            PhaseTime& time = summary.phases[phase];
+            time.threadMilliseconds += double(event.end - event.begin) * msPerTick;
+            ++time.calls;
+            firstBegin[phase] = std::min(firstBegin[phase], event.begin);
+            lastEnd[phase] = std::max(lastEnd[phase], event.end);
+
+            if (s.captureTrace) {
+                s.trace.push_back(TraceEvent{event.name, event.begin, event.end, ring->threadIndex});
+            }
+        }
+        ring->tail = head;
+    }
+    releaseRetired(s, drained);
+
+    for (size_t phase = 0; phase < summary.phaseCount; ++phase) {
+        summary.phases[phase].wallMilliseconds = double(lastEnd[phase] - firstBegin[phase]) * msPerTick;
+    }
+
+    if (s.captureTrace) {
+        s.counterSamples.push_back(CounterSample{stepEnd, counters});
+    }
+
+    s.lastSummary = summary;
+    return s.lastSummary;
+}
+
+const StepSummary& Profiler::getLastSummary() {
+    return state().lastSummary;
+}
+
+std::string Profiler::formatSummary(const StepSummary& summary) {
+    std::string out;
+    char buffer[160];
+
+    std::snprintf(buffer, sizeof(buffer), "step %llu: %.3f ms",
+                  static_cast<unsigned long long>(summary.step), summary.totalMilliseconds);
+    out += buffer;
+
+    for (size_t i = 0; i < summary.phaseCount; ++i) {
+        const PhaseTime& phase = summary.phases[i];
+        std::snprintf(buffer, sizeof(buffer), " | %s %.3f ms (x%u, %.3f ms thread)",
+                      phase.name, phase.wallMilliseconds, phase.calls, phase.threadMilliseconds);
+        out += buffer;
+    }
+
+    std::snprintf(buffer, sizeof(buffer), " | bodies %zu, contacts %zu, sleeping %zu",
+                  summary.counters.bodiesProcessed, summary.counters.contactPairs,
+                  summary.counters.sleepingBodies);
+    out += buffer;
+
+    if (summary.droppedEvents > 0) {
+        std::snprintf(buffer, sizeof(buffer), " | %llu events dropped",
+                      static_cast<unsigned long long>(summary.droppedEvents));
+        out += buffer;
+    }
+    return out;
+}
+
+bool Profiler::writeChromeTrace(const std::string& path) {
+    ProfilerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) return false;
+
+    // Timestamps are relative to the first recorded event, in microseconds
+    uint64_t origin = UINT64_MAX;
+    for (const TraceEvent& event : s.trace) origin = std::min(origin, event.begin);
+    for (const CounterSample& sample : s.counterSamples) origin = std::min(origin, sample.time);
+    if (origin == UINT64_MAX) origin = 0;
+
+    const double usPerTick = 1000.0 / ticksPerMillisecond();
+    std::string line;
+    bool first = true;
+    auto emit = [&](const std::string& text) {
+        std::fputs(first ? "\n" : ",\n", file);
+        std::fputs(text.c_str(), file);
+        first = false;
+    };
+
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", file);
+
+    // Name every thread that has events, including ones that have since exited
+    std::vector<bool> named(s.nextThreadIndex, false);
+    for (const TraceEvent& event : s.trace) named[event.threadIndex] = true;
+    for (const auto& ring : s.rings) named[ring->threadIndex] = true;
+    for (uint32_t thread = 0; thread < named.size(); ++thread) {
+        if (!named[thread]) continue;
+        char buffer[128];
+        std::snprintf(buffer, sizeof(buffer),
+                      "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+                      "\"args\":{\"name\":\"worker %u\"}}",
+                      thread, thread);
+        emit(buffer);
+    }
+
+    for (const TraceEvent& event : s.trace) {
+        char buffer[128];
+        line = "{\"name\":\"";
+        appendEscaped(line, event.name);
+        std::snprintf(buffer, sizeof(buffer),
+                      "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                      event.threadIndex, double(event.begin - origin) * usPerTick,
+                      double(event.end - event.begin) * usPerTick);
+        line += buffer;
+        emit(line);
+    }
+
+    for (const CounterSample& sample : s.counterSamples) {
+        char buffer[192];
+        std::snprintf(buffer, sizeof(buffer),
+                      "{\"name\":\"step\",\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,"
+                      "\"args\":{\"bodies\":%zu,\"contacts\":%zu,\"sleeping\":%zu}}",
+                      double(sample.time - origin) * usPerTick, sample.counters.bodiesProcessed,
+                      sample.counters.contactPairs, sample.counters.sleepingBodies);
+        emit(buffer);
+    }
+
+    std::fputs("\n]}\n", file);
+    return std::fclose(file) == 0;
+}
+
+void Profiler::reset() {
+    ProfilerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    std::vector<bool> drained(s.rings.size(), false);
+    for (size_t r = 0; r < s.rings.size(); ++r) {
+        ThreadRing* ring = s.rings[r].get();
+        drained[r] = ring->retired.load(std::memory_order_acquire);
+        ring->tail = ring->head.load(std::memory_order_acquire);
+    }
+    releaseRetired(s, drained);
+    s.trace.clear();
+    s.counterSamples.clear();
+    s.lastSummary = StepSummary();
+    s.stepOpen = false;
+}
+
+} // namespace archimedes3d
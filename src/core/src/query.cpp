@@ -0,0 +1,134 @@
+#include "../include/query.h"
+#include "../include/thread_pool.h"
+
+#include <algorithm>
+
+namespace archimedes3d {
+
+namespace {
+
+constexpr size_t kCaptureGrain = 4096;   // Bodies per parallel chunk
+
+} // namespace
+
+void WorldSnapshot::capture(const World& world, ThreadPool& pool) {
+    const size_t count = world.getBodyCount();
+    time = world.getTime();
+    stepCount = world.getStepCount();
+
+    positions.resize(count);
+    radii.resize(count);
+    materialIds.resize(count);
+    media.resize(count);
+
+    const float* sourceRadii = world.getRadii();
+    const MaterialId* sourceMaterials = world.getMaterialIds();
+
+    pool.parallelFor(count, kCaptureGrain, [&](size_t begin, size_t end) {
+        std::copy(sourceRadii + begin, sourceRadii + end, radii.begin() + begin);
+        std::copy(sourceMaterials + begin, sourceMaterials + end, materialIds.begin() + begin);
+        for (size_t i = begin; i < end; ++i) {
+            positions[i] = world.getPosition(static_cast<BodyId>(i));
+            media[i] = world.sampleMedium(positions[i]);
+        }
+    });
+
+    // Group bodies by medium with a counting sort, which keeps ids ascending
+    const size_t mediumCount = world.getMaterials().size();
+    mediumStart.assign(mediumCount + 1, 0);
+    mediumBodies.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (media[i] < mediumCount) ++mediumStart[media[i] + 1];
+    }
+    for (size_t m = 0; m < mediumCount; ++m) {
+        mediumStart[m + 1] += mediumStart[m];
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (media[i] < mediumCount) mediumBodies[mediumStart[media[i]]++] = static_cast<BodyId>(i);
+    }
+    for (size_t m = mediumCount; m > 0; --m) {
+        mediumStart[m] = mediumStart[m - 1];
+    }
+    mediumStart[0] = 0;
+
+    broadPhase.build(positions.data(), radii.data(), count);
+}
+
+const BodyId* WorldSnapshot::getBodiesInMedium(MaterialId medium, size_t& count) const {
+    if (size_t(medium) + 1 >= mediumStart.size()) {
+        count = 0;
+        return nullptr;
+    }
+    count = mediumStart[medium + 1] - mediumStart[medium];
+    return mediumBodies.data() + mediumStart[medium];
+}
+
+void QueryResults::reserve(size_t queryCount, size_t capacity) {
+    this->capacity = capacity;
+    counts.assign(queryCount, 0);
+    bodies.resize(queryCount * capacity);
+}
+
+SpatialQueries::SpatialQueries(ThreadPool& pool)
+    : pool(pool)
+{
+}
+
+SpatialQueries::SpatialQueries(size_t threadCount)
+    : ownedPool(std::make_unique<ThreadPool>(threadCount))
+    , pool(*ownedPool)
+{
+}
+
+SpatialQueries::~SpatialQueries() = default;
+
+void SpatialQueries::raycast(const WorldSnapshot& snapshot, const RayQuery* rays, size_t count, RayHit* hits) const {
+    const BroadPhase& broadPhase = snapshot.getBroadPhase();
+    const Vector3* positions = snapshot.getPositions();
+
+    pool.parallelFor(count, kQueryGrain, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const RayQuery& ray = rays[i];
+            RayHit& hit = hits[i];
+            double distance = 0.0;
+            const uint32_t body = broadPhase.raycast(ray.origin, ray.direction, ray.maxDistance, distance);
+
+            if (body == BroadPhase::kNone) {
+                hit = RayHit();
+                continue;
+            }
+
+            const Vector3 direction = ray.direction.normalized();
+            hit.body = body;
+            hit.distance = distance;
+            hit.point = ray.origin + direction * distance;
+            // A ray starting inside the body reports the surface facing back along it
+            hit.normal = distance > 0.0 ? (hit.point - positions[body]).normalized() : -direction;
+        }
+    });
+}
+
+void SpatialQueries::overlap(const WorldSnapshot& snapshot, const RegionQuery* regions, size_t count,
+                             QueryResults& results) const {
+    const BroadPhase& broadPhase = snapshot.getBroadPhase();
+    const MaterialId* media = snapshot.getMedia();
+    const size_t capacity = results.capacity;
+
+    pool.parallelFor(count, kQueryGrain, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const RegionQuery& region = regions[i];
+            BodyId* out = results.bodies.data() + i * capacity;
+            uint32_t found = 0;
+
+            broadPhase.forEachOverlapping(region.min, region.max, [&](uint32_t body) {
+                if (region.medium != kInvalidMaterial && media[body] != region.medium) return;
+                if (found < capacity) out[found] = body;
+                ++found;
+            });
+
+            results.counts[i] = found;
+        }
+    });
+}
+
+} // namespace archimedes3d
@@ -0,0 +1,427 @@
+#include "../include/scene.h"
+#include "../include/thread_pool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+
+namespace archimedes3d {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+constexpr char kMagic[4] = {'A', '3', 'D', 'S'};
+constexpr uint32_t kPerInstanceVelocities = 1;   // Array flag
+
+constexpr size_t kHeaderSize = 32;
+constexpr size_t kShapeSize = 32;
+constexpr size_t kArrayHeaderSize = 96;
+constexpr size_t kPositionSize = 3 * sizeof(double);
+constexpr size_t kVelocitySize = 3 * sizeof(float);
+
+// Appends plain values in host byte order (the format is little-endian)
+class ByteWriter {
+public:
+    explicit ByteWriter(std::vector<uint8_t>& bytes) : bytes(bytes) {}
+
+    template <typename T>
+    void put(const T& value) {
+        const size_t at = bytes.size();
+        bytes.resize(at + sizeof(T));
+        std::memcpy(bytes.data() + at, &value, sizeof(T));
+    }
+    void put(const Vector3& value) { put(value.x); put(value.y); put(value.z); }
+    void put(const Vector3f& value) { put(value.x); put(value.y); put(value.z); }
+    void putBytes(const void* data, size_t size) {
+        const size_t at = bytes.size();
+        bytes.resize(at + size);
+        std::memcpy(bytes.data() + at, data, size);
+    }
+
+private:
+    std::vector<uint8_t>& bytes;
+};
+
+// Bounds-checked sequential reads; once a read runs past the end every later one fails
+class ByteReader {
+public:
+    ByteReader(const uint8_t* data, size_t size) : data(data), size(size) {}
+
+    template <typename T>
+    bool get(T& value) {
+        if (!has(sizeof(T))) return false;
+        std::memcpy(&value, data + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+    bool get(Vector3& value) { return get(value.x) && get(value.y) && get(value.z); }
+    bool get(Vector3f& value) { return get(value.x) && get(value.y) && get(value.z); }
+
+    // Skip size bytes, returning where they start (nullptr past the end)
+    const uint8_t* skip(size_t bytes) {
+        if (!has(bytes)) return nullptr;
+        const uint8_t* start = data + offset;
+        offset += bytes;
+        return start;
+    }
+
+    bool has(size_t bytes) {
+        if (bytes > size - offset) {
+            offset = size;
+            valid = false;
+        }
+        return valid;
+    }
+
+private:
+    const uint8_t* data;
+    size_t size;
+    size_t offset = 0;
+    bool valid = true;
+};
+
+template <typename T>
+bool isFinite(const BasicVector3<T>& v) {
+    return std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z);
+}
+
+// Finite and not negative along every axis
+bool isLength(const Vector3& v) {
+    return isFinite(v) && v.x >= 0.0 && v.y >= 0.0 && v.z >= 0.0;
+}
+
+Vector3 readPosition(const uint8_t* at) {
+    double xyz[3];
+    std::memcpy(xyz, at, sizeof(xyz));
+    return Vector3(xyz[0], xyz[1], xyz[2]);
+}
+
+Vector3f readVelocity(const uint8_t* at) {
+    float xyz[3];
+    std::memcpy(xyz, at, sizeof(xyz));
+    return Vector3f(xyz[0], xyz[1], xyz[2]);
+}
+
+} // namespace
+
+double SceneShape::getVolume() const {
+    if (kind == Kind::Box) return size.x * size.y * size.z;
+    return 4.0 / 3.0 * kPi * size.x * size.x * size.x;
+}
+
+double SceneShape::getBoundingRadius() const {
+    return kind == Kind::Box ? 0.5 * size.length() : size.x;
+}
+
+size_t SceneArray::getCount() const {
+    if (layout == Layout::Grid) return size_t(gridSize[0]) * gridSize[1] * gridSize[2];
+    return positions.size();
+}
+
+uint32_t SceneWriter::addShape(const SceneShape& shape) {
+    shapes.push_back(shape);
+    return static_cast<uint32_t>(shapes.size() - 1);
+}
+
+uint32_t SceneWriter::addMaterial(const std::string& name) {
+    auto found = std::find(materials.begin(), materials.end(), name);
+    if (found != materials.end()) return static_cast<uint32_t>(found - materials.begin());
+    materials.push_back(name);
+    return static_cast<uint32_t>(materials.size() - 1);
+}
+
+bool SceneWriter::addArray(SceneArray array) {
+    const bool perInstance = array.layout == SceneArray::Layout::Explicit && !array.velocities.empty();
+    if (perInstance && array.velocities.size() != array.positions.size()) return false;
+    arrays.push_back(std::move(array));
+    return true;
+}
+
+size_t SceneWriter::getBodyCount() const {
+    size_t count = 0;
+    for (const SceneArray& array : arrays) count += array.getCount();
+    return count;
+}
+
+std::vector<uint8_t> SceneWriter::serialize() const {
+    std::vector<uint8_t> bytes;
+    size_t total = kHeaderSize + shapes.size() * kShapeSize;
+    for (const std::string& name : materials) total += sizeof(uint32_t) + name.size();
+    for (const SceneArray& array : arrays) {
+        total += kArrayHeaderSize;
+        if (array.layout == SceneArray::Layout::Explicit) {
+            total += array.positions.size() * kPositionSize + array.velocities.size() * kVelocitySize;
+        }
+    }
+    bytes.reserve(total);
+
+    ByteWriter out(bytes);
+    out.putBytes(kMagic, sizeof(kMagic));
+    out.put(SceneLoader::kVersion);
+    out.put(static_cast<uint32_t>(shapes.size()));
+    out.put(static_cast<uint32_t>(materials.size()));
+    out.put(static_cast<uint32_t>(arrays.size()));
+    out.put(uint32_t(0));
+    out.put(static_cast<uint64_t>(getBodyCount()));
+
+    for (const SceneShape& shape : shapes) {
+        out.put(static_cast<uint32_t>(shape.kind));
+        out.put(uint32_t(0));
+        out.put(shape.size);
+    }
+
+    for (const std::string& name : materials) {
+        out.put(static_cast<uint32_t>(name.size()));
+        out.putBytes(name.data(), name.size());
+    }
+
+    for (const SceneArray& array : arrays) {
+        const bool explicitLayout = array.layout == SceneArray::Layout::Explicit;
+        const bool perInstance = explicitLayout && !array.velocities.empty();
+
+        out.put(array.shape);
+        out.put(array.material);
+        out.put(static_cast<uint32_t>(array.layout));
+        out.put(perInstance ? kPerInstanceVelocities : uint32_t(0));
+        out.put(static_cast<uint64_t>(array.getCount()));
+        out.put(array.origin);
+        out.put(array.spacing);
+        for (uint32_t axis = 0; axis < 3; ++axis) out.put(array.gridSize[axis]);
+        out.put(array.velocity);
+
+        if (explicitLayout) {
+            for (const Vector3& position : array.positions) out.put(position);
+            if (perInstance) {
+                for (const Vector3f& velocity : array.velocities) out.put(velocity);
+            }
+        }
+    }
+    return bytes;
+}
+
+bool SceneWriter::write(const std::string& path) const {
+    const std::vector<uint8_t> bytes = serialize();
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+    const bool written = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    return std::fclose(file) == 0 && written;
+}
+
+SceneLoader::SceneLoader(ThreadPool* pool)
+    : pool(pool)
+{
+}
+
+template <typename Function>
+void SceneLoader::forEachBody(size_t count, Function&& function) {
+    if (pool) {
+        pool->parallelFor(count, kLoadGrain, function);
+    } else {
+        function(size_t(0), count);
+    }
+}
+
+bool SceneLoader::fail(const std::string& message) {
+    error = message;
+    return false;
+}
+
+bool SceneLoader::load(const std::string& path, World& world) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return fail("cannot open " + path);
+
+    std::vector<uint8_t> bytes;
+    bool read = std::fseek(file, 0, SEEK_END) == 0;
+    const long size = read ? std::ftell(file) : -1;
+    read = read && size >= 0 && std::fseek(file, 0, SEEK_SET) == 0;
+    if (read) {
+        bytes.resize(static_cast<size_t>(size));
+        read = std::fread(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    }
+    std::fclose(file);
+    if (!read) return fail("cannot read " + path);
+
+    return parse(bytes.data(), bytes.size(), world);
+}
+
+Vector3 SceneLoader::decodePosition(const ParsedArray& array, size_t index) {
+    if (array.layout == SceneArray::Layout::Explicit) {
+        return readPosition(array.positions + index * kPositionSize);
+    }
+    const size_t i = index % array.gridSize[0];
+    const size_t j = (index / array.gridSize[0]) % array.gridSize[1];
+    const size_t k = index / (size_t(array.gridSize[0]) * array.gridSize[1]);
+    return array.origin + Vector3(array.spacing.x * double(i), array.spacing.y * double(j), array.spacing.z * double(k));
+}
+
+bool SceneLoader::parse(const uint8_t* data, size_t size, World& world) {
+    error.clear();
+    parsed.clear();
+    bodyCount = 0;
+
+    // Header
+    ByteReader in(data, size);
+    const uint8_t* magic = in.skip(sizeof(kMagic));
+    if (!magic || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) return fail("not a scene file");
+
+    uint32_t version = 0, shapeCount = 0, materialCount = 0, arrayCount = 0, reserved = 0;
+    uint64_t totalBodies = 0;
+    if (!(in.get(version) && in.get(shapeCount) && in.get(materialCount) && in.get(arrayCount)
+          && in.get(reserved) && in.get(totalBodies))) {
+        return fail("truncated header");
+    }
+    if (version != kVersion) return fail("unsupported scene version " + std::to_string(version));
+
+    // Shapes
+    std::vector<SceneShape> shapes(shapeCount);
+    for (SceneShape& shape : shapes) {
+        uint32_t kind = 0;
+        if (!(in.get(kind) && in.get(reserved) && in.get(shape.size))) return fail("truncated shape table");
+        if (kind > uint32_t(SceneShape::Kind::Box)) return fail("unknown shape kind " + std::to_string(kind));
+        if (!isLength(shape.size)) return fail("invalid shape size");
+        shape.kind = static_cast<SceneShape::Kind>(kind);
+    }
+
+    // Material references, resolved by name
+    const MaterialTable& table = world.getMaterials();
+    std::vector<MaterialId> materials(materialCount);
+    for (MaterialId& material : materials) {
+        uint32_t length = 0;
+        const uint8_t* name = in.get(length) ? in.skip(length) : nullptr;
+        if (!name) return fail("truncated material table");
+        const std::string materialName(reinterpret_cast<const char*>(name), length);
+        material = table.find(materialName);
+        if (material == kInvalidMaterial) return fail("unknown material " + materialName);
+    }
+
+    // Array headers; explicit instance data is only located here and decoded in parallel below
+    parsed.resize(arrayCount);
+    size_t nextBody = 0;
+    const size_t maxBodies = std::numeric_limits<BodyId>::max() - world.getBodyCount();
+    for (ParsedArray& array : parsed) {
+        uint32_t shape = 0, material = 0, layout = 0, flags = 0;
+        uint64_t count = 0;
+        if (!(in.get(shape) && in.get(material) && in.get(layout) && in.get(flags) && in.get(count)
+              && in.get(array.origin) && in.get(array.spacing) && in.get(array.gridSize[0])
+              && in.get(array.gridSize[1]) && in.get(array.gridSize[2]) && in.get(array.velocity))) {
+            return fail("truncated array header");
+        }
+        if (shape >= shapeCount) return fail("array references missing shape " + std::to_string(shape));
+        if (material >= materialCount) return fail("array references missing material " + std::to_string(material));
+        if (layout > uint32_t(SceneArray::Layout::Grid)) return fail("unknown array layout " + std::to_string(layout));
+        if (layout == uint32_t(SceneArray::Layout::Grid)) {
+            if (!isFinite(array.origin)) return fail("invalid grid origin");
+            if (!isLength(array.spacing)) return fail("invalid grid spacing");
+        }
+        if (!isFinite(array.velocity)) return fail("invalid array velocity");
+        if (count > maxBodies - nextBody) return fail("too many bodies for the world");
+
+        array.firstBody = nextBody;
+        array.count = static_cast<size_t>(count);
+        array.layout = static_cast<SceneArray::Layout>(layout);
+        array.volume = shapes[shape].getVolume();
+        array.radius = shapes[shape].getBoundingRadius();
+        array.material = materials[material];
+        array.density = table.getDensity(array.material);
+        array.positions = nullptr;
+        array.velocities = nullptr;
+
+        if (array.layout == SceneArray::Layout::Grid) {
+            // Two 32-bit factors cannot wrap; the bound keeps the third from wrapping
+            const uint64_t rows = uint64_t(array.gridSize[0]) * array.gridSize[1];
+            const bool matches = array.gridSize[2] == 0 ? count == 0
+                : rows <= count / array.gridSize[2] && rows * array.gridSize[2] == count;
+            if (!matches) return fail("grid size does not match instance count");
+        } else {
+            if (count > size / kPositionSize) return fail("truncated instance data");
+            array.positions = in.skip(array.count * kPositionSize);
+            if ((flags & kPerInstanceVelocities) && array.positions) {
+                array.velocities = in.skip(array.count * kVelocitySize);
+                if (!array.velocities) return fail("truncated instance data");
+            }
+            if (!array.positions) return fail("truncated instance data");
+        }
+        nextBody += array.count;
+    }
+    if (nextBody != totalBodies) return fail("body count does not match the arrays");
+    if (nextBody == 0) return true;
+
+    // Instance data, checked in parallel while collecting the regions the bodies fall in.
+    // Each chunk reports its distinct regions; consecutive bodies mostly share one
+    std::mutex mutex;
+    std::vector<std::pair<uint64_t, Vector3>> regions;
+    size_t invalid = 0;
+    forEachBody(nextBody, [&](size_t begin, size_t end) {
+        auto array = std::upper_bound(parsed.begin(), parsed.end(), begin,
+                                      [](size_t body, const ParsedArray& a) { return body < a.firstBody; }) - 1;
+        std::unordered_map<uint64_t, Vector3> seen;
+        uint64_t lastKey = 0;
+        size_t rejected = 0;
+        for (size_t body = begin; body < end; ++body) {
+            while (body >= array->firstBody + array->count) ++array;
+            const size_t index = body - array->firstBody;
+            const Vector3 position = decodePosition(*array, index);
+            if (!World::isPlaceable(position)
+                || (array->velocities && !isFinite(readVelocity(array->velocities + index * kVelocitySize)))) {
+                ++rejected;
+                continue;
+            }
+            const uint64_t key = World::regionKey(position);
+            if (seen.empty() || key != lastKey) seen.emplace(key, position);
+            lastKey = key;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        invalid += rejected;
+        regions.insert(regions.end(), seen.begin(), seen.end());
+    });
+    if (invalid > 0) return fail("invalid position or velocity in " + std::to_string(invalid) + " instances");
+
+    // Everything is valid: append the bodies, open their regions and fill them in parallel
+    firstBody = world.addBodies(nextBody);
+    bodyCount = nextBody;
+
+    const Vector3Streams<float> velocities = world.getVelocities();
+    float* volumes = world.getVolumes();
+    float* radii = world.getRadii();
+    float* densities = world.getDensities();
+    MaterialId* materialIds = world.getMaterialIds();
+    double* temperatures = world.getTemperatures();
+
+    // Sorted so region ids do not depend on how the chunks were scheduled
+    std::sort(regions.begin(), regions.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (const auto& region : regions) {
+        world.openRegion(region.second);
+    }
+
+    forEachBody(bodyCount, [&](size_t begin, size_t end) {
+        // First array overlapping this chunk
+        auto array = std::upper_bound(parsed.begin(), parsed.end(), begin,
+                                      [](size_t body, const ParsedArray& a) { return body < a.firstBody; }) - 1;
+        for (size_t body = begin; body < end; ++body) {
+            while (body >= array->firstBody + array->count) ++array;
+
+            const size_t index = body - array->firstBody;
+            const BodyId id = static_cast<BodyId>(firstBody + body);
+            const Vector3 position = decodePosition(*array, index);
+
+            volumes[id] = static_cast<float>(array->volume);
+            radii[id] = static_cast<float>(array->radius);
+            densities[id] = static_cast<float>(array->density);
+            materialIds[id] = array->material;
+            velocities.store(id, array->velocities ? readVelocity(array->velocities + index * kVelocitySize)
+                                                   : array->velocity);
+            temperatures[id] = world.sampleMediumTemperature(position);
+            world.placeBody(id, position, false);
+        }
+    });
+
+    return true;
+}
+
+} // namespace archimedes3d
@@ -0,0 +1,129 @@
+#include "../include/thread_pool.h"
+
+#include <algorithm>
+
+namespace archimedes3d {
+
+ThreadPool::ThreadPool(size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    workers.reserve(threadCount - 1);
+    for (size_t i = 1; i < threadCount; ++i) {
+        workers.emplace_back([this] { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+std::future<void> ThreadPool::submit(std::function<void()> task) {
+    std::packaged_task<void()> packaged(std::move(task));
+    std::future<void> result = packaged.get_future();
+
+    if (workers.empty()) {
+        packaged();
+        return result;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(packaged));
+    }
+    wake.notify_one();
+    return result;
+}
+
+void ThreadPool::runChunks(Job& job) {
+    while (true) {
+        const size_t begin = job.next.fetch_add(job.grain, std::memory_order_relaxed);
+        if (begin >= job.count) break;
+        job.function(job.context, begin, std::min(begin + job.grain, job.count));
+    }
+}
+
+void ThreadPool::run(size_t count, size_t grain, ChunkFunction function, void* context) {
+    if (workers.empty() || count <= grain) {
+        function(context, 0, count);
+        return;
+    }
+
+    Job job;
+    job.function = function;
+    job.context = context;
+    job.count = count;
+    job.grain = grain;
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (activeJob) {
+            // Pool already busy with another parallelFor; stay on this thread
+            lock.unlock();
+            function(context, 0, count);
+            return;
+        }
+        activeJob = &job;
+        ++jobGeneration;
+    }
+    wake.notify_all();
+
+    runChunks(job);
+
+    // Stop new workers joining, then wait for those still inside a chunk
+    std::unique_lock<std::mutex> lock(mutex);
+    activeJob = nullptr;
+    jobDone.wait(lock, [&job] { return job.participants == 0; });
+}
+
+void ThreadPool::workerLoop() {
+    uint64_t seenGeneration = 0;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [&] {
+            return stopping || !tasks.empty() || (activeJob && jobGeneration != seenGeneration);
+        });
+
+        if (activeJob && jobGeneration != seenGeneration) {
+            seenGeneration = jobGeneration;
+            Job& job = *activeJob;
+            ++job.participants;
+            lock.unlock();
+
+            runChunks(job);
+
+            lock.lock();
+            if (--job.participants == 0) {
+                jobDone.notify_all();
+            }
+            continue;
+        }
+
+        if (!tasks.empty()) {
+            std::packaged_task<void()> task = std::move(tasks.front());
+            tasks.pop_front();
+            lock.unlock();
+            task();
+            lock.lock();
+            continue;
+        }
+
+        if (stopping) return;
+    }
+}
+
+} // namespace archimedes3d
@@ -0,0 +1,228 @@
+#include "../include/world.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace archimedes3d {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+constexpr int64_t kRegionKeyBias = int64_t(1) << 20;   // Region coordinates pack as 21-bit unsigned fields
+
+// Mutable access to data this world holds the only reference to, copying it first if shared
+template <typename T>
+T& detach(std::shared_ptr<const T>& shared) {
+    if (shared.use_count() != 1) {
+        shared = std::make_shared<T>(*shared);
+    }
+    return const_cast<T&>(*shared);
+}
+
+} // namespace
+
+World::World(WorldEnvironment environment)
+    : environment(std::move(environment))
+    , ambientMedium(kInvalidMaterial)
+    , time(0.0)
+    , stepCount(0)
+{
+    if (!this->environment.materials) {
+        this->environment.materials = MaterialTable::createBuiltin();
+    }
+    ambientMedium = this->environment.medium
+        ? this->environment.medium->getBackground()
+        : this->environment.materials->find("air");
+}
+
+MaterialTable& World::editMaterials() {
+    return detach(environment.materials);
+}
+
+MediumGrid* World::editMedium() {
+    return environment.medium ? &detach(environment.medium) : nullptr;
+}
+
+double World::sampleMediumDensity(const Vector3& position) const {
+    const MaterialId medium = sampleMedium(position);
+    if (medium == kInvalidMaterial) return 0.0;
+
+    const MaterialTable& materials = *environment.materials;
+    double density = materials.getDensity(medium);
+    if (environment.atmosphere && materials.getState(medium) == MaterialState::Gas) {
+        const Atmosphere& atmosphere = *environment.atmosphere;
+        density *= atmosphere.sampleDensity(position.z) / atmosphere.sampleDensity(0.0);
+    }
+    return density;
+}
+
+double World::sampleMediumTemperature(const Vector3& position) const {
+    // Inside the grid the voxel temperature; outside it the atmosphere's
+    const MediumGrid* medium = environment.medium.get();
+    size_t cell;
+    if (medium && medium->locate(position, cell)) {
+        return medium->getTemperatures()[cell];
+    }
+    if (environment.atmosphere) {
+        return environment.atmosphere->getTemperature(position.z);
+    }
+    return medium ? medium->getBackgroundTemperature() : Atmosphere::kSeaLevelTemperature;
+}
+
+bool World::isPlaceable(const Vector3& position) {
+    // Written so that NaN fails too
+    const double limit = kRegionSize * double(kRegionKeyBias);
+    return std::abs(position.x) < limit && std::abs(position.y) < limit && std::abs(position.z) < limit;
+}
+
+uint64_t World::regionKey(const Vector3& position) {
+    auto field = [](double coordinate) {
+        const int64_t cell = static_cast<int64_t>(std::floor(coordinate / kRegionSize)) + kRegionKeyBias;
+        return static_cast<uint64_t>(cell) & 0x1fffff;
+    };
+    return field(position.x) | (field(position.y) << 21) | (field(position.z) << 42);
+}
+
+uint32_t World::findRegion(const Vector3& position, bool create) {
+    const uint64_t key = regionKey(position);
+    auto found = regionLookup.find(key);
+    if (found != regionLookup.end()) return found->second;
+    if (!create) return kNoRegion;
+
+    const Vector3 origin((std::floor(position.x / kRegionSize) + 0.5) * kRegionSize,
+                         (std::floor(position.y / kRegionSize) + 0.5) * kRegionSize,
+                         (std::floor(position.z / kRegionSize) + 0.5) * kRegionSize);
+    const uint32_t region = static_cast<uint32_t>(regionOrigins.size());
+    regionOrigins.push_back(origin);
+    regionHeights.push_back(static_cast<float>(origin.z));
+    regionLookup.emplace(key, region);
+    return region;
+}
+
+BodyId World::addBody(const Vector3& position, double volume, double radius, MaterialId material,
+                      const Vector3& velocity) {
+    const BodyId id = addBodies(1);
+    placeBody(id, position, true);
+    getVelocities().store(id, Vector3f(velocity));
+    volumes[id] = static_cast<float>(volume);
+    radii[id] = static_cast<float>(radius);
+    densities[id] = static_cast<float>(environment.materials->getDensity(material));
+    materialIds[id] = material;
+    temperatures[id] = sampleMediumTemperature(position);
+    return id;
+}
+
+BodyId World::addSphere(const Vector3& position, double radius, MaterialId material, const Vector3& velocity) {
+    return addBody(position, 4.0 / 3.0 * kPi * radius * radius * radius, radius, material, velocity);
+}
+
+BodyId World::addBodies(size_t count) {
+    const size_t first = regionIds.size();
+    const size_t total = first + count;
+    for (std::vector<float>* stream : {&positionX, &positionY, &positionZ, &velocityX, &velocityY, &velocityZ,
+                                       &forceX, &forceY, &forceZ, &volumes, &radii, &densities}) {
+        stream->resize(total, 0.0f);
+    }
+    regionIds.resize(total, kNoRegion);
+    materialIds.resize(total, kInvalidMaterial);
+    temperatures.resize(total, 0.0);
+    sleeping.resize(total, 0);
+    sleepCounters.resize(total, 0);
+    return static_cast<BodyId>(first);
+}
+
+void World::reserveBodies(size_t count) {
+    for (std::vector<float>* stream : {&positionX, &positionY, &positionZ, &velocityX, &velocityY, &velocityZ,
+                                       &forceX, &forceY, &forceZ, &volumes, &radii, &densities}) {
+        stream->reserve(count);
+    }
+    regionIds.reserve(count);
+    materialIds.reserve(count);
+    temperatures.reserve(count);
+    sleeping.reserve(count);
+    sleepCounters.reserve(count);
+}
+
+void World::clearBodies() {
+    for (std::vector<float>* stream : {&positionX, &positionY, &positionZ, &velocityX, &velocityY, &velocityZ,
+                                       &forceX, &forceY, &forceZ, &volumes, &radii, &densities}) {
+        stream->clear();
+    }
+    regionIds.clear();
+    materialIds.clear();
+    temperatures.clear();
+    sleeping.clear();
+    sleepCounters.clear();
+}
+
+void World::setPosition(BodyId id, const Vector3& value) {
+    placeBody(id, value, true);
+    wake(id);
+}
+
+bool World::placeBody(BodyId id, const Vector3& position, bool createRegion) {
+    const uint32_t region = findRegion(position, createRegion);
+    regionIds[id] = region;
+    if (region == kNoRegion) return false;
+    getLocalPositions().store(id, Vector3f(position - regionOrigins[region]));
+    return true;
+}
+
+void World::setMaterial(BodyId id, MaterialId material, bool conserveMass) {
+    const double density = environment.materials->getDensity(material);
+    if (conserveMass && density > 0.0) {
+        const double scale = densities[id] / density;
+        volumes[id] = static_cast<float>(volumes[id] * scale);
+        radii[id] = static_cast<float>(radii[id] * std::cbrt(scale));
+    }
+    materialIds[id] = material;
+    densities[id] = static_cast<float>(density);
+    wake(id);
+}
+
+void World::applyForce(BodyId id, const Vector3& force) {
+    forceX[id] += static_cast<float>(force.x);
+    forceY[id] += static_cast<float>(force.y);
+    forceZ[id] += static_cast<float>(force.z);
+    wake(id);
+}
+
+void World::applyImpulse(BodyId id, const Vector3& impulse) {
+    const Vector3 change = impulse / getMass(id);
+    velocityX[id] += static_cast<float>(change.x);
+    velocityY[id] += static_cast<float>(change.y);
+    velocityZ[id] += static_cast<float>(change.z);
+    wake(id);
+}
+
+void World::wakeAll() {
+    std::fill(sleeping.begin(), sleeping.end(), uint8_t(0));
+    std::fill(sleepCounters.begin(), sleepCounters.end(), uint16_t(0));
+}
+
+size_t World::rebaseBodies(size_t begin, size_t end, bool createRegions) {
+    size_t remaining = 0;
+    for (size_t i = begin; i < end; ++i) {
+        if (!isStray(positionX[i], positionY[i], positionZ[i])) continue;
+
+        const Vector3 position = getPosition(static_cast<BodyId>(i));
+        const uint32_t region = findRegion(position, createRegions);
+        if (region == kNoRegion) {
+            ++remaining;
+            continue;
+        }
+        getLocalPositions().store(i, Vector3f(position - regionOrigins[region]));
+        regionIds[i] = region;
+    }
+    return remaining;
+}
+
+void World::refreshDensities() {
+    const MaterialTable& materials = *environment.materials;
+    for (size_t i = 0; i < materialIds.size(); ++i) {
+        densities[i] = static_cast<float>(materials.getDensity(materialIds[i]));
+    }
+}
+
+} // namespace archimedes3d
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace archimedes3d {
+
+/**
+ * Standard atmosphere (ISA) density profile, valid up to 86 km
+ */
+class Atmosphere {
+public:
+    // Physical constants
+    static constexpr double kGravity = 9.80665;          // m/s², standard gravity
+    static constexpr double kGasConstantAir = 287.053;    // J/(kg·K), specific gas constant
+
+    // Sea-level reference conditions
+    static constexpr double kSeaLevelTemperature = 288.15;  // K
+    static constexpr double kSeaLevelPressure = 101325.0;   // Pa
+
+    static constexpr double kCeiling = 86000.0;           // m, top of the model
+
+    // Constructors
+    Atmosphere();
+    Atmosphere(double seaLevelTemperature, double seaLevelPressure);
+
+    // Profile lookups; altitudes are clamped to [0, kCeiling]
+    double getTemperature(double altitude) const;  // K
+    double getPressure(double altitude) const;     // Pa
+    double getDensity(double altitude) const;      // kg/m³
+
+    double getSeaLevelTemperature() const { return seaLevelTemperature; }
+    double getSeaLevelPressure() const { return seaLevelPressure; }
+    double getSeaLevelDensity() const { return getDensity(0.0); }
+
+    // Tabulated density, linearly interpolated; cheap enough for per-body kernels
+    double sampleDensity(double altitude) const {
+        const double position = std::min(std::max(altitude, 0.0), kCeiling) * (1.0 / kTableSpacing);
+        const size_t index = std::min(static_cast<size_t>(position), densityTable.size() - 2);
+        const double t = position - double(index);
+        return densityTable[index] + t * (densityTable[index + 1] - densityTable[index]);
+    }
+
+private:
+    static constexpr int kLayerCount = 7;
+    static constexpr double kTableSpacing = 50.0;   // m between density table entries
+
+    double seaLevelTemperature;
+    double seaLevelPressure;
+
+    // Base temperature and pressure of each layer, derived from sea level
+    double baseTemperature[kLayerCount];
+    double basePressure[kLayerCount];
+
+    std::vector<double> densityTable;
+
+    int findLayer(double altitude) const;
+};
+
+} // namespace archimedes3d
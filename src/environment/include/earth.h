@@ -0,0 +1,127 @@
+#pragma once
+
+#include "atmosphere.h"
+#include "../../materials/include/material.h"
+#include "../../math/include/numerical.h"
+#include "../../math/include/vectors.h"
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace archimedes3d {
+
+// Forward declarations
+class ThreadPool;
+
+/**
+ * Tunable parameters of the ocean surface
+ */
+struct OceanSettings {
+    size_t resolution = 128;             // Grid points per tile side, rounded up to a power of two
+    double patchSize = 256.0;            // m, side of the repeating tile
+    double windSpeed = 12.0;             // m/s, sets the dominant wavelength (V²/g)
+    Vector3 windDirection{1.0, 0.0, 0.0};// Horizontal; z is ignored
+    double significantWaveHeight = 2.0;  // m, mean height of the highest third of waves (4σ)
+    double seaLevel = 0.0;               // m, mean surface height
+    uint64_t seed = 1;                   // Random phases of the spectrum
+};
+
+/**
+ * Ocean surface state above one horizontal position
+ */
+struct OceanSample {
+    double height = 0.0;     // m, absolute surface height
+    Vector3 normal{0.0, 0.0, 1.0};
+    Vector3 velocity;        // m/s, orbital velocity of the water at the surface
+};
+
+/**
+ * Deep-water ocean surface synthesised from a Phillips spectrum (Tessendorf).
+ *
+ * Each update evaluates the spectrum at the current time and runs three 2D
+ * inverse FFTs, each carrying two real fields (height + vertical velocity,
+ * both slopes, both horizontal velocities). Rows and then columns are
+ * transformed in parallel. The result is a periodic grid of packed texels
+ * that tiles seamlessly over the whole plane, so a query is one bilinear
+ * lookup of four neighbouring texels, independent of the number of waves.
+ */
+class OceanSurface {
+public:
+    OceanSurface(std::shared_ptr<LiquidMaterial> liquid, const OceanSettings& settings = OceanSettings());
+
+    // Re-synthesise the surface at an absolute time
+    void update(double time, ThreadPool& pool);
+    double getTime() const { return time; }
+
+    // Queries; x and y wrap around the tile, z is ignored
+    double getHeight(double x, double y) const;
+    OceanSample sample(const Vector3& position) const;
+    void sample(const Vector3* positions, size_t count, OceanSample* samples) const;
+
+    // Access
+    const std::shared_ptr<LiquidMaterial>& getLiquid() const { return liquid; }
+    double getDensity() const { return liquid->getDensity(); }
+    const OceanSettings& getSettings() const { return settings; }
+    size_t getResolution() const { return n; }
+
+private:
+    // One grid point of the synthesised surface, relative to sea level
+    struct Texel {
+        float height;
+        float slopeX, slopeY;
+        float velocityX, velocityY, velocityZ;
+    };
+
+    void initializeSpectrum();
+    void synthesizeRows(double time, size_t begin, size_t end);
+    void transformColumns(size_t begin, size_t end);
+
+    std::shared_ptr<LiquidMaterial> liquid;
+    OceanSettings settings;
+
+    size_t n;
+    size_t mask;
+    double inverseTexelSize;   // Grid points per metre
+    double time;
+    Fft<float> fft;
+
+    // Initial spectrum h0(k), conj(h0(-k)) and dispersion ω(k)
+    std::vector<std::complex<float>> spectrum;
+    std::vector<std::complex<float>> spectrumMirror;
+    std::vector<float> angularFrequency;
+
+    // FFT work arrays, each two real fields packed as re + i·im
+    std::vector<std::complex<float>> heightAndVerticalVelocity;
+    std::vector<std::complex<float>> slopes;
+    std::vector<std::complex<float>> horizontalVelocity;
+
+    std::vector<Texel> texels;
+};
+
+/**
+ * The planet a scene takes place on: standard atmosphere plus a wave-driven
+ * ocean surface
+ */
+class Earth {
+public:
+    static constexpr double kGravity = Atmosphere::kGravity;   // m/s²
+    static constexpr double kRadius = 6.371e6;                 // m, mean radius
+
+    Earth();
+    Earth(std::shared_ptr<LiquidMaterial> oceanLiquid, const OceanSettings& oceanSettings);
+
+    // Advance the clock and re-synthesise the ocean, once per step
+    void step(double dt, ThreadPool& pool);
+    double getTime() const { return time; }
+
+    const Atmosphere& getAtmosphere() const { return atmosphere; }
+    const OceanSurface& getOcean() const { return ocean; }
+
+private:
+    Atmosphere atmosphere;
+    OceanSurface ocean;
+    double time;
+};
+
+} // namespace archimedes3d
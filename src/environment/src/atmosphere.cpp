@@ -0,0 +1,76 @@
+#include "../include/atmosphere.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace archimedes3d {
+
+namespace {
+
+// ISA layer base altitudes (m) and temperature lapse rates (K/m)
+constexpr double kLayerBase[] = {0.0, 11000.0, 20000.0, 32000.0, 47000.0, 51000.0, 71000.0};
+constexpr double kLapseRate[] = {-0.0065, 0.0, 0.001, 0.0028, 0.0, -0.0028, -0.002};
+
+double layerPressure(double basePressure, double baseTemperature, double lapseRate, double height) {
+    constexpr double exponent = Atmosphere::kGravity / Atmosphere::kGasConstantAir;
+    if (lapseRate == 0.0) {
+        return basePressure * std::exp(-exponent * height / baseTemperature);
+    }
+    const double temperature = baseTemperature + lapseRate * height;
+    return basePressure * std::pow(baseTemperature / temperature, exponent / lapseRate);
+}
+
+} // namespace
+
+Atmosphere::Atmosphere()
+    : Atmosphere(kSeaLevelTemperature, kSeaLevelPressure)
+{
+}
+
+Atmosphere::Atmosphere(double seaLevelTemperature, double seaLevelPressure)
+    : seaLevelTemperature(seaLevelTemperature)
+    , seaLevelPressure(seaLevelPressure)
+{
+    baseTemperature[0] = seaLevelTemperature;
+    basePressure[0] = seaLevelPressure;
+
+    for (int i = 1; i < kLayerCount; ++i) {
+        const double height = kLayerBase[i] - kLayerBase[i - 1];
+        baseTemperature[i] = baseTemperature[i - 1] + kLapseRate[i - 1] * height;
+        basePressure[i] = layerPressure(basePressure[i - 1], baseTemperature[i - 1], kLapseRate[i - 1], height);
+    }
+
+    const size_t entries = static_cast<size_t>(kCeiling / kTableSpacing) + 1;
+    densityTable.resize(entries);
+    for (size_t i = 0; i < entries; ++i) {
+        densityTable[i] = getDensity(double(i) * kTableSpacing);
+    }
+}
+
+int Atmosphere::findLayer(double altitude) const {
+    int layer = 0;
+    while (layer + 1 < kLayerCount && altitude >= kLayerBase[layer + 1]) {
+        ++layer;
+    }
+    return layer;
+}
+
+double Atmosphere::getTemperature(double altitude) const {
+    altitude = std::clamp(altitude, 0.0, kCeiling);
+    const int layer = findLayer(altitude);
+    return baseTemperature[layer] + kLapseRate[layer] * (altitude - kLayerBase[layer]);
+}
+
+double Atmosphere::getPressure(double altitude) const {
+    altitude = std::clamp(altitude, 0.0, kCeiling);
+    const int layer = findLayer(altitude);
+    return layerPressure(basePressure[layer], baseTemperature[layer], kLapseRate[layer],
+                         altitude - kLayerBase[layer]);
+}
+
+double Atmosphere::getDensity(double altitude) const {
+    // Ideal gas law: ρ = P / (R·T)
+    return getPressure(altitude) / (kGasConstantAir * getTemperature(altitude));
+}
+
+} // namespace archimedes3d
@@ -0,0 +1,256 @@
+#include "../include/earth.h"
+#include "../../core/include/profiler.h"
+#include "../../core/include/thread_pool.h"
+#include "../../materials/include/liquid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace archimedes3d {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+constexpr size_t kRowGrain = 8;               // FFT rows/columns per parallel chunk
+constexpr double kSmallWaveFraction = 1.0e-3; // Waves shorter than this fraction of V²/g are suppressed
+constexpr double kCounterWindEnergy = 0.1;    // Energy kept by waves travelling against the wind
+
+// Components of a + i·b where a and b are complex (two real fields in one FFT)
+inline std::complex<float> pack(const std::complex<float>& a, const std::complex<float>& b) {
+    return {a.real() - b.imag(), a.imag() + b.real()};
+}
+
+} // namespace
+
+OceanSurface::OceanSurface(std::shared_ptr<LiquidMaterial> liquid, const OceanSettings& settings)
+    : liquid(std::move(liquid))
+    , settings(settings)
+    , n(nextPowerOfTwo(std::max<size_t>(settings.resolution, 2)))
+    , mask(n - 1)
+    , inverseTexelSize(double(n) / settings.patchSize)
+    , time(0.0)
+    , fft(n)
+    , spectrum(n * n)
+    , spectrumMirror(n * n)
+    , angularFrequency(n * n)
+    , heightAndVerticalVelocity(n * n)
+    , slopes(n * n)
+    , horizontalVelocity(n * n)
+    , texels(n * n)
+{
+    initializeSpectrum();
+    synthesizeRows(0.0, 0, n);
+    transformColumns(0, n);
+}
+
+void OceanSurface::initializeSpectrum() {
+    const double g = Atmosphere::kGravity;
+    const double kScale = 2.0 * kPi / settings.patchSize;
+
+    double windX = settings.windDirection.x;
+    double windY = settings.windDirection.y;
+    const double windLength = std::sqrt(windX * windX + windY * windY);
+    if (windLength > 0.0) {
+        windX /= windLength;
+        windY /= windLength;
+    } else {
+        windX = 1.0;
+        windY = 0.0;
+    }
+
+    const double dominant = std::max(settings.windSpeed * settings.windSpeed / g, 1.0e-6);
+    const double small = dominant * kSmallWaveFraction;
+
+    // Phillips spectrum with random Gaussian amplitudes, in double until scaled
+    std::mt19937_64 random(settings.seed);
+    std::normal_distribution<double> gaussian;
+    std::vector<std::complex<double>> amplitudes(n * n);
+
+    for (size_t iy = 0; iy < n; ++iy) {
+        for (size_t ix = 0; ix < n; ++ix) {
+            const size_t index = iy * n + ix;
+            const double kx = kScale * (ix < n / 2 ? double(ix) : double(ix) - double(n));
+            const double ky = kScale * (iy < n / 2 ? double(iy) : double(iy) - double(n));
+            const double k = std::sqrt(kx * kx + ky * ky);
+            angularFrequency[index] = static_cast<float>(std::sqrt(g * k));
+
+            // Draw both numbers for every bin so the pattern does not depend on which are skipped
+            const double real = gaussian(random);
+            const double imag = gaussian(random);
+
+            // The mean level and the Nyquist row/column (which has no
+            // distinct mirror frequency) carry no energy
+            if (k == 0.0 || ix == n / 2 || iy == n / 2) continue;
+
+            const double alignment = (kx * windX + ky * windY) / k;
+            double phillips = std::exp(-1.0 / (k * dominant * k * dominant)) / (k * k * k * k)
+                            * alignment * alignment * std::exp(-k * k * small * small);
+            if (alignment < 0.0) phillips *= kCounterWindEnergy;
+
+            amplitudes[index] = std::complex<double>(real, imag) * std::sqrt(phillips * 0.5);
+        }
+    }
+
+    // Scale so the synthesised surface has the requested significant wave
+    // height; by Parseval, mean(η²) = Σ|H(k)|² with H(k) = h0(k) + conj(h0(-k))
+    double variance = 0.0;
+    for (size_t iy = 0; iy < n; ++iy) {
+        for (size_t ix = 0; ix < n; ++ix) {
+            const size_t mirror = ((n - iy) & mask) * n + ((n - ix) & mask);
+            variance += std::norm(amplitudes[iy * n + ix] + std::conj(amplitudes[mirror]));
+        }
+    }
+    const double scale = variance > 0.0 ? settings.significantWaveHeight / (4.0 * std::sqrt(variance)) : 0.0;
+
+    for (size_t iy = 0; iy < n; ++iy) {
+        for (size_t ix = 0; ix < n; ++ix) {
+            const size_t mirror = ((n - iy) & mask) * n + ((n - ix) & mask);
+            spectrum[iy * n + ix] = std::complex<float>(amplitudes[iy * n + ix] * scale);
+            spectrumMirror[iy * n + ix] = std::complex<float>(std::conj(amplitudes[mirror]) * scale);
+        }
+    }
+}
+
+void OceanSurface::update(double time, ThreadPool& pool) {
+    ARCHIMEDES3D_PROFILE_SCOPE("ocean fft");
+    this->time = time;
+    pool.parallelFor(n, kRowGrain, [&](size_t begin, size_t end) {
+        synthesizeRows(time, begin, end);
+    });
+    pool.parallelFor(n, kRowGrain, [&](size_t begin, size_t end) {
+        transformColumns(begin, end);
+    });
+}
+
+void OceanSurface::synthesizeRows(double time, size_t begin, size_t end) {
+    const float kScale = static_cast<float>(2.0 * kPi / settings.patchSize);
+
+    for (size_t iy = begin; iy < end; ++iy) {
+        const float ky = kScale * (iy < n / 2 ? float(iy) : float(iy) - float(n));
+
+        for (size_t ix = 0; ix < n; ++ix) {
+            const size_t index = iy * n + ix;
+            const float kx = kScale * (ix < n / 2 ? float(ix) : float(ix) - float(n));
+            const float k = std::sqrt(kx * kx + ky * ky);
+            const float omega = angularFrequency[index];
+
+            // Phase in double: ω·t grows without bound
+            const double phase = double(omega) * time;
+            const float c = static_cast<float>(std::cos(phase));
+            const float s = static_cast<float>(std::sin(phase));
+
+            // Wave travelling along +k, P = h0(k)·e^(-iωt), and its mirror
+            // partner travelling along -k, M = conj(h0(-k))·e^(iωt)
+            const std::complex<float> a = spectrum[index];
+            const std::complex<float> b = spectrumMirror[index];
+            const std::complex<float> forward(a.real() * c + a.imag() * s, a.imag() * c - a.real() * s);
+            const std::complex<float> backward(b.real() * c - b.imag() * s, b.real() * s + b.imag() * c);
+
+            const std::complex<float> height = forward + backward;
+            const std::complex<float> travel = forward - backward;
+
+            // ∂η/∂t = -iω·(P - M); horizontal velocity ω·k̂·(P - M); slope i·k·H
+            const std::complex<float> vertical(omega * travel.imag(), -omega * travel.real());
+            const float speedX = k > 0.0f ? omega * kx / k : 0.0f;
+            const float speedY = k > 0.0f ? omega * ky / k : 0.0f;
+            const std::complex<float> slopeX(-kx * height.imag(), kx * height.real());
+            const std::complex<float> slopeY(-ky * height.imag(), ky * height.real());
+
+            heightAndVerticalVelocity[index] = pack(height, vertical);
+            slopes[index] = pack(slopeX, slopeY);
+            horizontalVelocity[index] = pack(travel * speedX, travel * speedY);
+        }
+
+        fft.inverse(&heightAndVerticalVelocity[iy * n]);
+        fft.inverse(&slopes[iy * n]);
+        fft.inverse(&horizontalVelocity[iy * n]);
+    }
+}
+
+void OceanSurface::transformColumns(size_t begin, size_t end) {
+    for (size_t ix = begin; ix < end; ++ix) {
+        fft.inverse(&heightAndVerticalVelocity[ix], n);
+        fft.inverse(&slopes[ix], n);
+        fft.inverse(&horizontalVelocity[ix], n);
+
+        for (size_t iy = 0; iy < n; ++iy) {
+            const size_t index = iy * n + ix;
+            Texel& texel = texels[index];
+            texel.height = heightAndVerticalVelocity[index].real();
+            texel.velocityZ = heightAndVerticalVelocity[index].imag();
+            texel.slopeX = slopes[index].real();
+            texel.slopeY = slopes[index].imag();
+            texel.velocityX = horizontalVelocity[index].real();
+            texel.velocityY = horizontalVelocity[index].imag();
+        }
+    }
+}
+
+double OceanSurface::getHeight(double x, double y) const {
+    return sample(Vector3(x, y, 0.0)).height;
+}
+
+OceanSample OceanSurface::sample(const Vector3& position) const {
+    OceanSample result;
+    sample(&position, 1, &result);
+    return result;
+}
+
+void OceanSurface::sample(const Vector3* positions, size_t count, OceanSample* samples) const {
+    const Texel* grid = texels.data();
+
+    for (size_t i = 0; i < count; ++i) {
+        // Bilinear lookup; the tile is periodic, so indices simply wrap
+        const double u = positions[i].x * inverseTexelSize;
+        const double v = positions[i].y * inverseTexelSize;
+        const double u0 = std::floor(u);
+        const double v0 = std::floor(v);
+        const float fx = static_cast<float>(u - u0);
+        const float fy = static_cast<float>(v - v0);
+
+        const size_t x0 = static_cast<size_t>(static_cast<int64_t>(u0)) & mask;
+        const size_t y0 = static_cast<size_t>(static_cast<int64_t>(v0)) & mask;
+        const size_t x1 = (x0 + 1) & mask;
+        const size_t y1 = (y0 + 1) & mask;
+
+        const Texel& t00 = grid[y0 * n + x0];
+        const Texel& t10 = grid[y0 * n + x1];
+        const Texel& t01 = grid[y1 * n + x0];
+        const Texel& t11 = grid[y1 * n + x1];
+
+        const float w00 = (1.0f - fx) * (1.0f - fy);
+        const float w10 = fx * (1.0f - fy);
+        const float w01 = (1.0f - fx) * fy;
+        const float w11 = fx * fy;
+
+        auto blend = [&](float Texel::*field) {
+            return w00 * t00.*field + w10 * t10.*field + w01 * t01.*field + w11 * t11.*field;
+        };
+
+        OceanSample& sample = samples[i];
+        sample.height = settings.seaLevel + blend(&Texel::height);
+        sample.normal = Vector3(-blend(&Texel::slopeX), -blend(&Texel::slopeY), 1.0).normalized();
+        sample.velocity = Vector3(blend(&Texel::velocityX), blend(&Texel::velocityY), blend(&Texel::velocityZ));
+    }
+}
+
+Earth::Earth()
+    : Earth(LiquidMaterials::get("saltwater"), OceanSettings())
+{
+}
+
+Earth::Earth(std::shared_ptr<LiquidMaterial> oceanLiquid, const OceanSettings& oceanSettings)
+    : atmosphere()
+    , ocean(std::move(oceanLiquid), oceanSettings)
+    , time(0.0)
+{
+}
+
+void Earth::step(double dt, ThreadPool& pool) {
+    time += dt;
+    ocean.update(time, pool);
+}
+
+} // namespace archimedes3d
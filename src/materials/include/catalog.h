@@ -0,0 +1,198 @@
+#pragma once
+
+#include "material.h"
+#include "material_table.h"
+#include <array>
+#include <memory>
+#include <string_view>
+
+namespace archimedes3d {
+
+/**
+ * Compile-time description of a built-in material.
+ *
+ * The three state properties are interpreted by state:
+ *   Solid:  elasticity (Pa), tensile strength (Pa), hardness (Mohs)
+ *   Liquid: viscosity (Pa·s), surface tension (N/m), freezing point (K)
+ *   Gas:    compression factor (Z), expansion coefficient (1/K), unused
+ *   Plasma: ionization level (0-1), electron density (1/m³), plasma frequency (Hz)
+ */
+struct MaterialSpec {
+    const char* key;                  // Registry name, e.g. "water"
+    const char* name;                 // Display name, e.g. "Water"
+    MaterialState state;
+    double density;                   // kg/m³
+    std::array<double, 3> properties; // State-specific, see above
+    double electricalConductivity;    // S/m
+    double magneticPermeability;      // Relative
+    double thermalConductivity;       // W/(m·K)
+    double specificHeat;              // J/(kg·K)
+};
+
+namespace detail {
+
+constexpr MaterialSpec solidSpec(const char* key, const char* name, double density,
+                                 double elasticity, double tensileStrength, double hardness,
+                                 double sigma, double mu, double k, double c) {
+    return {key, name, MaterialState::Solid, density, {elasticity, tensileStrength, hardness}, sigma, mu, k, c};
+}
+
+constexpr MaterialSpec liquidSpec(const char* key, const char* name, double density,
+                                  double viscosity, double surfaceTension, double freezingPoint,
+                                  double sigma, double mu, double k, double c) {
+    return {key, name, MaterialState::Liquid, density, {viscosity, surfaceTension, freezingPoint}, sigma, mu, k, c};
+}
+
+constexpr MaterialSpec gasSpec(const char* key, const char* name, double density,
+                               double compressionFactor, double expansionCoefficient,
+                               double sigma, double mu, double k, double c) {
+    return {key, name, MaterialState::Gas, density, {compressionFactor, expansionCoefficient, 0.0}, sigma, mu, k, c};
+}
+
+constexpr MaterialSpec plasmaSpec(const char* key, const char* name, double density,
+                                  double ionizationLevel, double electronDensity, double plasmaFrequency,
+                                  double sigma, double mu, double k, double c) {
+    return {key, name, MaterialState::Plasma, density, {ionizationLevel, electronDensity, plasmaFrequency}, sigma, mu, k, c};
+}
+
+} // namespace detail
+
+/**
+ * The built-in materials, in MaterialTable::createBuiltin() order
+ * (gas, liquid, solid, plasma), so a catalog index is also the built-in
+ * table's MaterialId.
+ */
+inline constexpr std::array<MaterialSpec, 36> kBuiltinMaterials = {{
+    //              key               name              ρ kg/m³   Z         β 1/K       σ S/m     μ          k W/(m·K)  c J/(kg·K)
+    detail::gasSpec("air",            "Air",            1.225,    1.0,      3.43e-3,    3.0e-15,  1.0,       0.026,     1005.0),
+    detail::gasSpec("helium",         "Helium",         0.1786,   1.0004,   3.665e-3,   0.0,      1.0,       0.151,     5193.0),
+    detail::gasSpec("hydrogen",       "Hydrogen",       0.0899,   1.0006,   3.661e-3,   0.0,      1.0,       0.182,     14304.0),
+    detail::gasSpec("oxygen",         "Oxygen",         1.429,    0.9994,   3.43e-3,    0.0,      1.000002,  0.026,     919.0),
+    detail::gasSpec("carbon_dioxide", "Carbon Dioxide", 1.98,     0.9942,   3.37e-3,    0.0,      1.0,       0.0166,    843.0),
+    detail::gasSpec("methane",        "Methane",        0.668,    0.998,    3.56e-3,    0.0,      1.0,       0.034,     2220.0),
+    detail::gasSpec("steam",          "Steam",          0.6,      0.975,    1.66e-3,    1.0e-16,  1.0,       0.025,     2080.0),
+    detail::gasSpec("nitrogen",       "Nitrogen",       1.2506,   0.9998,   3.67e-3,    0.0,      0.99999,   0.026,     1040.0),
+    detail::gasSpec("argon",          "Argon",          1.784,    0.9994,   3.68e-3,    0.0,      1.0,       0.018,     520.0),
+
+    //                 key                name               ρ kg/m³   η Pa·s    γ N/m    T_f K     σ S/m     μ     k W/(m·K)  c J/(kg·K)
+    detail::liquidSpec("water",           "Water",           1000.0,   0.001,    0.072,   273.15,   5.5e-6,   1.0,  0.598,     4182.0),
+    detail::liquidSpec("saltwater",       "Saltwater",       1025.0,   0.00108,  0.073,   271.15,   5.0,      1.0,  0.596,     3993.0),
+    detail::liquidSpec("oil",             "Vegetable Oil",   920.0,    0.04,     0.032,   263.15,   1.0e-11,  1.0,  0.17,      1670.0),
+    detail::liquidSpec("gasoline",        "Gasoline",        750.0,    0.0006,   0.022,   183.15,   1.0e-14,  1.0,  0.15,      2220.0),
+    detail::liquidSpec("mercury",         "Mercury",         13600.0,  0.00152,  0.487,   234.32,   1.0e6,    1.0,  8.3,       140.0),
+    detail::liquidSpec("ethanol",         "Ethanol",         789.0,    0.00112,  0.022,   159.05,   1.0e-7,   1.0,  0.171,     2440.0),
+    detail::liquidSpec("blood",           "Blood",           1060.0,   0.004,    0.058,   271.35,   0.7,      1.0,  0.492,     3650.0),
+    detail::liquidSpec("honey",           "Honey",           1420.0,   10.0,     0.07,    253.15,   1.0e-6,   1.0,  0.5,       2260.0),
+    detail::liquidSpec("liquid_nitrogen", "Liquid Nitrogen", 808.0,    0.000158, 0.0089,  63.15,    1.0e-16,  1.0,  0.1396,    1040.0),
+
+    //                key         name        ρ kg/m³   E Pa      UTS Pa     Mohs   σ S/m     μ          k W/(m·K)  c J/(kg·K)
+    detail::solidSpec("wood",     "Wood",     700.0,    11.0e9,   50.0e6,    3.0,   1.0e-14,  1.0,       0.12,      1700.0),
+    detail::solidSpec("ice",      "Ice",      917.0,    9.5e9,    1.0e6,     1.5,   1.0e-10,  1.0,       2.18,      2100.0),
+    detail::solidSpec("concrete", "Concrete", 2400.0,   30.0e9,   3.0e6,     7.0,   1.0e-6,   1.0,       1.7,       880.0),
+    detail::solidSpec("aluminum", "Aluminum", 2700.0,   69.0e9,   310.0e6,   2.75,  3.5e7,    1.000022,  237.0,     897.0),
+    detail::solidSpec("steel",    "Steel",    7850.0,   200.0e9,  400.0e6,   4.5,   6.99e6,   100.0,     50.2,      490.0),
+    detail::solidSpec("copper",   "Copper",   8960.0,   117.0e9,  220.0e6,   3.0,   5.96e7,   0.999994,  401.0,     385.0),
+    detail::solidSpec("lead",     "Lead",     11340.0,  16.0e9,   18.0e6,    1.5,   4.55e6,   0.99998,   35.3,      129.0),
+    detail::solidSpec("gold",     "Gold",     19300.0,  79.0e9,   120.0e6,   2.5,   4.52e7,   0.99996,   317.0,     129.0),
+    detail::solidSpec("aerogel",  "Aerogel",  3.0,      1.0e6,    16.0e3,    0.5,   1.0e-15,  1.0,       0.013,     1000.0),
+
+    //                 key                name               ρ kg/m³   ionized  n_e 1/m³  f_p Hz    σ S/m     μ     k W/(m·K)  c J/(kg·K)
+    detail::plasmaSpec("ionized_air",     "Ionized Air",     1.0,      0.01,    1.0e16,   8.9e9,    0.1,      1.0,  0.3,       1005.0),
+    detail::plasmaSpec("solar_plasma",    "Solar Plasma",    1.0e-4,   1.0,     1.0e20,   1.0e15,   1.0e7,    1.0,  100.0,     20000.0),
+    detail::plasmaSpec("neon_plasma",     "Neon Plasma",     0.9,      0.1,     1.0e18,   2.8e11,   5.0e3,    1.0,  0.05,      1000.0),
+    detail::plasmaSpec("argon_plasma",    "Argon Plasma",    1.78,     0.15,    5.0e18,   3.2e11,   8.0e3,    1.0,  0.02,      520.0),
+    detail::plasmaSpec("hydrogen_plasma", "Hydrogen Plasma", 0.09,     0.95,    1.0e19,   5.0e11,   1.0e4,    1.0,  0.18,      14300.0),
+    detail::plasmaSpec("helium_plasma",   "Helium Plasma",   0.18,     0.8,     8.0e18,   4.0e11,   9.0e3,    1.0,  0.15,      5193.0),
+    detail::plasmaSpec("xenon_plasma",    "Xenon Plasma",    5.9,      0.3,     2.0e18,   2.5e11,   3.0e3,    1.0,  0.006,     160.0),
+    detail::plasmaSpec("mercury_plasma",  "Mercury Plasma",  13.6,     0.25,    1.5e18,   2.2e11,   1.0e4,    1.0,  0.01,      140.0),
+    detail::plasmaSpec("plasma_jet",      "Plasma Jet",      0.5,      0.9,     1.0e20,   5.6e11,   2.0e5,    1.0,  5.0,       10000.0),
+}};
+
+/**
+ * Lookup and runtime construction over kBuiltinMaterials
+ */
+class MaterialCatalog {
+public:
+    static constexpr size_t size() { return kBuiltinMaterials.size(); }
+
+    // Catalog index (== built-in MaterialId) of a registry key, or kInvalidMaterial
+    static constexpr MaterialId indexOf(std::string_view key) {
+        for (size_t i = 0; i < kBuiltinMaterials.size(); ++i) {
+            if (key == kBuiltinMaterials[i].key) return static_cast<MaterialId>(i);
+        }
+        return kInvalidMaterial;
+    }
+
+    static constexpr const MaterialSpec* find(std::string_view key) {
+        const MaterialId id = indexOf(key);
+        return id != kInvalidMaterial ? &kBuiltinMaterials[id] : nullptr;
+    }
+
+    // Runtime objects for the registries; each call makes a new instance
+    static std::shared_ptr<Material> create(const MaterialSpec& spec);
+    static std::shared_ptr<SolidMaterial> createSolid(const MaterialSpec& spec);
+    static std::shared_ptr<LiquidMaterial> createLiquid(const MaterialSpec& spec);
+    static std::shared_ptr<GasMaterial> createGas(const MaterialSpec& spec);
+    static std::shared_ptr<PlasmaMaterial> createPlasma(const MaterialSpec& spec);
+};
+
+/**
+ * Tag types naming each built-in material by its registry key
+ */
+namespace materials {
+
+// Gases
+struct Air            { static constexpr const char* key = "air"; };
+struct Helium         { static constexpr const char* key = "helium"; };
+struct Hydrogen       { static constexpr const char* key = "hydrogen"; };
+struct Oxygen         { static constexpr const char* key = "oxygen"; };
+struct CarbonDioxide  { static constexpr const char* key = "carbon_dioxide"; };
+struct Methane        { static constexpr const char* key = "methane"; };
+struct Steam          { static constexpr const char* key = "steam"; };
+struct Nitrogen       { static constexpr const char* key = "nitrogen"; };
+struct Argon          { static constexpr const char* key = "argon"; };
+
+// Liquids
+struct Water          { static constexpr const char* key = "water"; };
+struct Saltwater      { static constexpr const char* key = "saltwater"; };
+struct Oil            { static constexpr const char* key = "oil"; };
+struct Gasoline       { static constexpr const char* key = "gasoline"; };
+struct Mercury        { static constexpr const char* key = "mercury"; };
+struct Ethanol        { static constexpr const char* key = "ethanol"; };
+struct Blood          { static constexpr const char* key = "blood"; };
+struct Honey          { static constexpr const char* key = "honey"; };
+struct LiquidNitrogen { static constexpr const char* key = "liquid_nitrogen"; };
+
+// Solids
+struct Wood           { static constexpr const char* key = "wood"; };
+struct Ice            { static constexpr const char* key = "ice"; };
+struct Concrete       { static constexpr const char* key = "concrete"; };
+struct Aluminum       { static constexpr const char* key = "aluminum"; };
+struct Steel          { static constexpr const char* key = "steel"; };
+struct Copper         { static constexpr const char* key = "copper"; };
+struct Lead           { static constexpr const char* key = "lead"; };
+struct Gold           { static constexpr const char* key = "gold"; };
+struct Aerogel        { static constexpr const char* key = "aerogel"; };
+
+// Plasmas
+struct IonizedAir     { static constexpr const char* key = "ionized_air"; };
+struct SolarPlasma    { static constexpr const char* key = "solar_plasma"; };
+struct NeonPlasma     { static constexpr const char* key = "neon_plasma"; };
+struct ArgonPlasma    { static constexpr const char* key = "argon_plasma"; };
+struct HydrogenPlasma { static constexpr const char* key = "hydrogen_plasma"; };
+struct HeliumPlasma   { static constexpr const char* key = "helium_plasma"; };
+struct XenonPlasma    { static constexpr const char* key = "xenon_plasma"; };
+struct MercuryPlasma  { static constexpr const char* key = "mercury_plasma"; };
+struct PlasmaJet      { static constexpr const char* key = "plasma_jet"; };
+
+} // namespace materials
+
+// Built-in MaterialId of a tag, e.g. world.addSphere(p, r, material_id_v<materials::Wood>)
+template <typename Tag>
+inline constexpr MaterialId material_id_v = MaterialCatalog::indexOf(Tag::key);
+
+// Compile-time properties of a tag, e.g. material_v<materials::Water>.density
+template <typename Tag>
+inline constexpr const MaterialSpec& material_v = kBuiltinMaterials[material_id_v<Tag>];
+
+} // namespace archimedes3d
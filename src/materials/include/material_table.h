@@ -0,0 +1,70 @@
+#pragma once
+
+#include "material.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace archimedes3d {
+
+using MaterialId = uint16_t;
+constexpr MaterialId kInvalidMaterial = 0xffff;
+
+enum class MaterialState : uint8_t {
+    Solid,
+    Liquid,
+    Gas,
+    Plasma
+};
+
+/**
+ * Packed, index-addressed view of a set of materials.
+ *
+ * Kernels read per-material properties from flat arrays by MaterialId
+ * instead of chasing shared_ptr<Material>. A table is immutable once shared
+ * between worlds; a World copies it before modifying (see World::editMaterials).
+ */
+class MaterialTable {
+public:
+    MaterialTable() = default;
+
+    // Registration; key is the registry name (e.g. "water")
+    MaterialId add(const std::string& key, std::shared_ptr<const Material> material);
+
+    // Lookup
+    MaterialId find(const std::string& key) const;
+    size_t size() const { return materials.size(); }
+
+    const std::string& getKey(MaterialId id) const { return keys[id]; }
+    const Material& getMaterial(MaterialId id) const { return *materials[id]; }
+    const std::shared_ptr<const Material>& getMaterialPointer(MaterialId id) const { return materials[id]; }
+
+    // Packed properties
+    double getDensity(MaterialId id) const { return densities[id]; }
+    double getSpecificHeat(MaterialId id) const { return specificHeats[id]; }
+    double getThermalConductivity(MaterialId id) const { return thermalConductivities[id]; }
+    double getElectricalConductivity(MaterialId id) const { return electricalConductivities[id]; }
+    MaterialState getState(MaterialId id) const { return states[id]; }
+
+    const double* getDensities() const { return densities.data(); }
+    const MaterialState* getStates() const { return states.data(); }
+
+    // Per-run perturbation (Monte Carlo); affects only this table
+    void setDensity(MaterialId id, double value) { densities[id] = value; }
+
+    // All built-in registry materials; ids follow kBuiltinMaterials (see catalog.h)
+    static std::shared_ptr<const MaterialTable> createBuiltin();
+
+private:
+    std::vector<std::string> keys;
+    std::vector<std::shared_ptr<const Material>> materials;
+
+    std::vector<double> densities;
+    std::vector<double> specificHeats;
+    std::vector<double> thermalConductivities;
+    std::vector<double> electricalConductivities;
+    std::vector<MaterialState> states;
+};
+
+} // namespace archimedes3d
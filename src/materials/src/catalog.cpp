@@ -0,0 +1,61 @@
+#include "../include/catalog.h"
+
+namespace archimedes3d {
+
+namespace {
+
+void applyCommon(Material& material, const MaterialSpec& spec) {
+    material.setElectricalConductivity(spec.electricalConductivity);
+    material.setMagneticPermeability(spec.magneticPermeability);
+    material.setThermalConductivity(spec.thermalConductivity);
+    material.setSpecificHeat(spec.specificHeat);
+}
+
+} // namespace
+
+std::shared_ptr<Material> MaterialCatalog::create(const MaterialSpec& spec) {
+    switch (spec.state) {
+        case MaterialState::Solid:  return createSolid(spec);
+        case MaterialState::Liquid: return createLiquid(spec);
+        case MaterialState::Gas:    return createGas(spec);
+        case MaterialState::Plasma: return createPlasma(spec);
+    }
+    return nullptr;
+}
+
+std::shared_ptr<SolidMaterial> MaterialCatalog::createSolid(const MaterialSpec& spec) {
+    auto solid = std::make_shared<SolidMaterial>(spec.name, spec.density);
+    solid->setElasticity(spec.properties[0]);
+    solid->setTensileStrength(spec.properties[1]);
+    solid->setHardness(spec.properties[2]);
+    applyCommon(*solid, spec);
+    return solid;
+}
+
+std::shared_ptr<LiquidMaterial> MaterialCatalog::createLiquid(const MaterialSpec& spec) {
+    auto liquid = std::make_shared<LiquidMaterial>(spec.name, spec.density);
+    liquid->setViscosity(spec.properties[0]);
+    liquid->setSurfaceTension(spec.properties[1]);
+    liquid->setFreezingPoint(spec.properties[2]);
+    applyCommon(*liquid, spec);
+    return liquid;
+}
+
+std::shared_ptr<GasMaterial> MaterialCatalog::createGas(const MaterialSpec& spec) {
+    auto gas = std::make_shared<GasMaterial>(spec.name, spec.density);
+    gas->setCompressionFactor(spec.properties[0]);
+    gas->setExpansionCoefficient(spec.properties[1]);
+    applyCommon(*gas, spec);
+    return gas;
+}
+
+std::shared_ptr<PlasmaMaterial> MaterialCatalog::createPlasma(const MaterialSpec& spec) {
+    auto plasma = std::make_shared<PlasmaMaterial>(spec.name, spec.density);
+    plasma->setIonizationLevel(spec.properties[0]);
+    plasma->setElectronDensity(spec.properties[1]);
+    plasma->setPlasmaFrequency(spec.properties[2]);
+    applyCommon(*plasma, spec);
+    return plasma;
+}
+
+} // namespace archimedes3d
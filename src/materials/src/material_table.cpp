@@ -0,0 +1,66 @@
+#include "../include/material_table.h"
+#include "../include/catalog.h"
+#include "../include/gas.h"
+#include "../include/liquid.h"
+#include "../include/plasma.h"
+#include "../include/solid.h"
+
+namespace archimedes3d {
+
+namespace {
+
+MaterialState stateOf(const Material& material) {
+    if (material.isSolid()) return MaterialState::Solid;
+    if (material.isLiquid()) return MaterialState::Liquid;
+    if (material.isPlasma()) return MaterialState::Plasma;
+    return MaterialState::Gas;
+}
+
+} // namespace
+
+MaterialId MaterialTable::add(const std::string& key, std::shared_ptr<const Material> material) {
+    const MaterialId existing = find(key);
+    const MaterialId id = existing != kInvalidMaterial ? existing : static_cast<MaterialId>(materials.size());
+
+    if (existing == kInvalidMaterial) {
+        keys.push_back(key);
+        materials.push_back(nullptr);
+        densities.push_back(0.0);
+        specificHeats.push_back(0.0);
+        thermalConductivities.push_back(0.0);
+        electricalConductivities.push_back(0.0);
+        states.push_back(MaterialState::Gas);
+    }
+
+    densities[id] = material->getDensity();
+    specificHeats[id] = material->getSpecificHeat();
+    thermalConductivities[id] = material->getThermalConductivity();
+    electricalConductivities[id] = material->getElectricalConductivity();
+    states[id] = stateOf(*material);
+    materials[id] = std::move(material);
+    return id;
+}
+
+MaterialId MaterialTable::find(const std::string& key) const {
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (keys[i] == key) return static_cast<MaterialId>(i);
+    }
+    return kInvalidMaterial;
+}
+
+std::shared_ptr<const MaterialTable> MaterialTable::createBuiltin() {
+    auto table = std::make_shared<MaterialTable>();
+
+    // Catalog order, so material_id_v<Tag> is valid for this table
+    for (const MaterialSpec& spec : kBuiltinMaterials) {
+        switch (spec.state) {
+            case MaterialState::Solid:  table->add(spec.key, SolidMaterials::get(spec.key)); break;
+            case MaterialState::Liquid: table->add(spec.key, LiquidMaterials::get(spec.key)); break;
+            case MaterialState::Gas:    table->add(spec.key, GasMaterials::get(spec.key)); break;
+            case MaterialState::Plasma: table->add(spec.key, PlasmaMaterials::get(spec.key)); break;
+        }
+    }
+    return table;
+}
+
+} // namespace archimedes3d
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace archimedes3d {
+
+constexpr bool isPowerOfTwo(size_t value) {
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+constexpr size_t nextPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+/**
+ * Iterative radix-2 FFT of one fixed power-of-two size.
+ *
+ * Bit-reversal permutation and twiddle factors are computed once, so a plan
+ * can be shared between threads and applied to many rows or columns (any
+ * stride) without allocating. Transforms are unnormalised: inverse(forward(x))
+ * is size·x.
+ */
+template <typename T>
+class Fft {
+public:
+    explicit Fft(size_t size)
+        : n(nextPowerOfTwo(size))
+        , reversed(n)
+        , twiddles(n / 2)
+    {
+        size_t bits = 0;
+        while ((size_t(1) << bits) < n) ++bits;
+        for (size_t i = 0; i < n; ++i) {
+            size_t r = 0;
+            for (size_t b = 0; b < bits; ++b) {
+                r |= ((i >> b) & 1) << (bits - 1 - b);
+            }
+            reversed[i] = r;
+        }
+
+        const double pi = 3.14159265358979323846;
+        for (size_t i = 0; i < n / 2; ++i) {
+            const double angle = -2.0 * pi * double(i) / double(n);
+            twiddles[i] = std::complex<T>(T(std::cos(angle)), T(std::sin(angle)));
+        }
+    }
+
+    size_t size() const { return n; }
+
+    // X[k] = Σ x[m]·e^(-2πi·km/n)
+    void forward(std::complex<T>* data, size_t stride = 1) const { transform(data, stride, false); }
+
+    // x[m] = Σ X[k]·e^(+2πi·km/n)
+    void inverse(std::complex<T>* data, size_t stride = 1) const { transform(data, stride, true); }
+
+private:
+    void transform(std::complex<T>* data, size_t stride, bool inverse) const {
+        for (size_t i = 0; i < n; ++i) {
+            const size_t r = reversed[i];
+            if (i < r) std::swap(data[i * stride], data[r * stride]);
+        }
+
+        for (size_t length = 2; length <= n; length <<= 1) {
+            const size_t half = length / 2;
+            const size_t step = n / length;
+            for (size_t start = 0; start < n; start += length) {
+                for (size_t j = 0; j < half; ++j) {
+                    std::complex<T> w = twiddles[j * step];
+                    if (inverse) w = std::conj(w);
+                    std::complex<T>& a = data[(start + j) * stride];
+                    std::complex<T>& b = data[(start + j + half) * stride];
+                    // Written out: operator* on std::complex goes through the
+                    // NaN-aware libgcc helper unless -ffast-math is on
+                    const std::complex<T> t(b.real() * w.real() - b.imag() * w.imag(),
+                                            b.real() * w.imag() + b.imag() * w.real());
+                    b = a - t;
+                    a += t;
+                }
+            }
+        }
+    }
+
+    size_t n;
+    std::vector<size_t> reversed;
+    std::vector<std::complex<T>> twiddles;
+};
+
+} // namespace archimedes3d
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+namespace archimedes3d {
+
+/**
+ * 3D vector, double precision for world space and float for compact storage
+ */
+template <typename T>
+struct BasicVector3 {
+    T x, y, z;
+
+    constexpr BasicVector3() : x(0), y(0), z(0) {}
+    constexpr BasicVector3(T x, T y, T z) : x(x), y(y), z(z) {}
+
+    template <typename U>
+    constexpr explicit BasicVector3(const BasicVector3<U>& other)
+        : x(static_cast<T>(other.x)), y(static_cast<T>(other.y)), z(static_cast<T>(other.z)) {}
+
+    // Arithmetic
+    constexpr BasicVector3 operator+(const BasicVector3& v) const { return {x + v.x, y + v.y, z + v.z}; }
+    constexpr BasicVector3 operator-(const BasicVector3& v) const { return {x - v.x, y - v.y, z - v.z}; }
+    constexpr BasicVector3 operator-() const { return {-x, -y, -z}; }
+    constexpr BasicVector3 operator*(T s) const { return {x * s, y * s, z * s}; }
+    constexpr BasicVector3 operator/(T s) const { return {x / s, y / s, z / s}; }
+
+    BasicVector3& operator+=(const BasicVector3& v) { x += v.x; y += v.y; z += v.z; return *this; }
+    BasicVector3& operator-=(const BasicVector3& v) { x -= v.x; y -= v.y; z -= v.z; return *this; }
+    BasicVector3& operator*=(T s) { x *= s; y *= s; z *= s; return *this; }
+    BasicVector3& operator/=(T s) { x /= s; y /= s; z /= s; return *this; }
+
+    constexpr bool operator==(const BasicVector3& v) const { return x == v.x && y == v.y && z == v.z; }
+    constexpr bool operator!=(const BasicVector3& v) const { return !(*this == v); }
+
+    // Products and norms
+    constexpr T dot(const BasicVector3& v) const { return x * v.x + y * v.y + z * v.z; }
+    constexpr BasicVector3 cross(const BasicVector3& v) const {
+        return {y * v.z - z * v.y, z * v.x - x * v.z, x * v.y - y * v.x};
+    }
+
+    constexpr T lengthSquared() const { return dot(*this); }
+    T length() const { return std::sqrt(lengthSquared()); }
+
+    BasicVector3 normalized() const {
+        const T len = length();
+        return len > T(0) ? *this / len : BasicVector3();
+    }
+};
+
+template <typename T>
+constexpr BasicVector3<T> operator*(T s, const BasicVector3<T>& v) { return v * s; }
+
+using Vector3 = BasicVector3<double>;
+using Vector3f = BasicVector3<float>;
+
+/**
+ * Structure-of-arrays view of many vectors: one contiguous stream per axis,
+ * the layout vectorised kernels want
+ */
+template <typename T>
+struct Vector3Streams {
+    T* x;
+    T* y;
+    T* z;
+
+    BasicVector3<std::remove_const_t<T>> load(size_t i) const { return {x[i], y[i], z[i]}; }
+    void store(size_t i, const BasicVector3<T>& v) const { x[i] = v.x; y[i] = v.y; z[i] = v.z; }
+};
+
+} // namespace archimedes3d
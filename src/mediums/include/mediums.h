@@ -0,0 +1,92 @@
+#pragma once
+
+#include "../../environment/include/atmosphere.h"
+#include "../../materials/include/material_table.h"
+#include "../../math/include/vectors.h"
+#include <cstdint>
+#include <vector>
+
+namespace archimedes3d {
+
+/**
+ * Uniform voxel grid assigning a medium material and a temperature to every
+ * cell of space.
+ *
+ * Points outside the grid fall back to the background material (normally
+ * air). The grid is shared read-only between worlds; a World copies it
+ * before editing (see World::editMedium).
+ */
+class MediumGrid {
+public:
+    MediumGrid(const Vector3& origin, double cellSize, uint32_t cellsX, uint32_t cellsY, uint32_t cellsZ,
+               MaterialId background, double backgroundTemperature = Atmosphere::kSeaLevelTemperature);
+
+    // Geometry
+    const Vector3& getOrigin() const { return origin; }
+    double getCellSize() const { return cellSize; }
+    uint32_t getCellsX() const { return cellsX; }
+    uint32_t getCellsY() const { return cellsY; }
+    uint32_t getCellsZ() const { return cellsZ; }
+    size_t getCellCount() const { return cells.size(); }
+
+    MaterialId getBackground() const { return background; }
+    double getBackgroundTemperature() const { return backgroundTemperature; }
+
+    // Cell access
+    MaterialId getCell(uint32_t x, uint32_t y, uint32_t z) const { return cells[index(x, y, z)]; }
+    void setCell(uint32_t x, uint32_t y, uint32_t z, MaterialId material) { cells[index(x, y, z)] = material; }
+
+    const MaterialId* getCells() const { return cells.data(); }
+    MaterialId* getCells() { return cells.data(); }
+
+    // Cell temperatures, K
+    double getTemperature(uint32_t x, uint32_t y, uint32_t z) const { return temperatures[index(x, y, z)]; }
+    void setTemperature(uint32_t x, uint32_t y, uint32_t z, double value) { temperatures[index(x, y, z)] = float(value); }
+
+    const float* getTemperatures() const { return temperatures.data(); }
+    float* getTemperatures() { return temperatures.data(); }
+
+    // Fill every cell whose centre lies in [min, max)
+    void fillBox(const Vector3& min, const Vector3& max, MaterialId material);
+
+    // Medium and temperature at a world-space point
+    MaterialId sample(const Vector3& position) const {
+        size_t cell;
+        return locate(position, cell) ? cells[cell] : background;
+    }
+
+    double sampleTemperature(const Vector3& position) const {
+        size_t cell;
+        return locate(position, cell) ? double(temperatures[cell]) : backgroundTemperature;
+    }
+
+    // Index of the cell containing a point; false outside the grid
+    bool locate(const Vector3& position, size_t& cell) const {
+        const double inverse = 1.0 / cellSize;
+        const double fx = (position.x - origin.x) * inverse;
+        const double fy = (position.y - origin.y) * inverse;
+        const double fz = (position.z - origin.z) * inverse;
+        if (fx < 0.0 || fy < 0.0 || fz < 0.0 || fx >= cellsX || fy >= cellsY || fz >= cellsZ) {
+            return false;
+        }
+        cell = index(uint32_t(fx), uint32_t(fy), uint32_t(fz));
+        return true;
+    }
+
+    size_t index(uint32_t x, uint32_t y, uint32_t z) const {
+        return x + size_t(cellsX) * (y + size_t(cellsY) * z);
+    }
+
+    Vector3 getCellCenter(size_t cellIndex) const;
+
+private:
+    Vector3 origin;
+    double cellSize;
+    uint32_t cellsX, cellsY, cellsZ;
+    MaterialId background;
+    double backgroundTemperature;   // K
+    std::vector<MaterialId> cells;
+    std::vector<float> temperatures;
+};
+
+} // namespace archimedes3d
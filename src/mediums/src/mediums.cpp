@@ -0,0 +1,52 @@
+#include "../include/mediums.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace archimedes3d {
+
+MediumGrid::MediumGrid(const Vector3& origin, double cellSize, uint32_t cellsX, uint32_t cellsY, uint32_t cellsZ,
+                       MaterialId background, double backgroundTemperature)
+    : origin(origin)
+    , cellSize(cellSize)
+    , cellsX(cellsX)
+    , cellsY(cellsY)
+    , cellsZ(cellsZ)
+    , background(background)
+    , backgroundTemperature(backgroundTemperature)
+    , cells(size_t(cellsX) * cellsY * cellsZ, background)
+    , temperatures(cells.size(), float(backgroundTemperature))
+{
+}
+
+void MediumGrid::fillBox(const Vector3& min, const Vector3& max, MaterialId material) {
+    // Cell i covers [origin + i·size, origin + (i+1)·size); test its centre
+    auto range = [this](double low, double high, double start, uint32_t cells, uint32_t& first, uint32_t& last) {
+        const double a = std::ceil((low - start) / cellSize - 0.5);
+        const double b = std::ceil((high - start) / cellSize - 0.5);
+        first = static_cast<uint32_t>(std::clamp(a, 0.0, double(cells)));
+        last = static_cast<uint32_t>(std::clamp(b, 0.0, double(cells)));
+    };
+
+    uint32_t x0, x1, y0, y1, z0, z1;
+    range(min.x, max.x, origin.x, cellsX, x0, x1);
+    range(min.y, max.y, origin.y, cellsY, y0, y1);
+    range(min.z, max.z, origin.z, cellsZ, z0, z1);
+
+    for (uint32_t z = z0; z < z1; ++z) {
+        for (uint32_t y = y0; y < y1; ++y) {
+            for (uint32_t x = x0; x < x1; ++x) {
+                cells[index(x, y, z)] = material;
+            }
+        }
+    }
+}
+
+Vector3 MediumGrid::getCellCenter(size_t cellIndex) const {
+    const size_t x = cellIndex % cellsX;
+    const size_t y = (cellIndex / cellsX) % cellsY;
+    const size_t z = cellIndex / (size_t(cellsX) * cellsY);
+    return origin + Vector3((x + 0.5) * cellSize, (y + 0.5) * cellSize, (z + 0.5) * cellSize);
+}
+
+} // namespace archimedes3d
@@ -0,0 +1,172 @@
+#pragma once
+
+#include "../../materials/include/material.h"
+#include "../../math/include/vectors.h"
+#include <cstddef>
+#include <memory>
+
+namespace archimedes3d {
+
+// Forward declarations
+class Atmosphere;
+class OceanSurface;
+class ThreadPool;
+struct OceanSample;
+
+/**
+ * How a balloon is currently being advanced
+ */
+enum class BalloonRegime {
+    Integrating,   // Full force integration every step
+    Ascending,     // Quasi-steady: moving at terminal velocity, advanced analytically
+    Floating       // Settling onto / resting at the equilibrium altitude
+};
+
+/**
+ * Zero-pressure balloon: the envelope fills with lifting gas at ambient
+ * pressure until it reaches its maximum volume, after which excess gas vents.
+ *
+ * While nothing disturbs it, a balloon reaches terminal velocity within a few
+ * steps; from then on it is advanced in closed form (ascent at terminal
+ * velocity, then exponential settling onto the equilibrium altitude) and only
+ * returns to full integration when a force, impulse or burner change arrives.
+ */
+class Balloon {
+public:
+    Balloon(std::shared_ptr<GasMaterial> liftingGas, double gasMass, double maxVolume, double payloadMass);
+
+    // State
+    double getAltitude() const { return altitude; }
+    void setAltitude(double value) { altitude = value; disturb(); }
+
+    double getVerticalVelocity() const { return verticalVelocity; }
+    void setVerticalVelocity(double value) { verticalVelocity = value; disturb(); }
+
+    BalloonRegime getRegime() const { return regime; }
+
+    // Properties
+    const std::shared_ptr<GasMaterial>& getLiftingGas() const { return liftingGas; }
+
+    double getGasMass() const { return gasMass; }
+    double getMaxVolume() const { return maxVolume; }
+    double getPayloadMass() const { return payloadMass; }
+
+    double getDragCoefficient() const { return dragCoefficient; }
+    void setDragCoefficient(double value) { dragCoefficient = value; disturb(); }
+
+    // Temperature excess of the lifting gas over ambient, K (hot-air burner)
+    double getSuperheat() const { return superheat; }
+    void setSuperheat(double value) { superheat = value; disturb(); }
+
+    // Physics at an arbitrary altitude, for the current gas charge
+    double calculateGasDensity(const Atmosphere& atmosphere, double altitude) const;
+    double calculateVolume(const Atmosphere& atmosphere, double altitude) const;
+    double calculateStaticForce(const Atmosphere& atmosphere, double altitude) const;   // Lift minus weight, N
+    double calculateTerminalVelocity(const Atmosphere& atmosphere, double altitude) const;
+    double calculateEquilibriumAltitude(const Atmosphere& atmosphere) const;
+
+    // Forces and impulses always drop the balloon back to full integration
+    void applyForce(double force);
+    void applyImpulse(double impulse);
+    void disturb();
+
+    // Advance by dt, choosing the cheapest valid regime
+    void step(const Atmosphere& atmosphere, double dt);
+
+private:
+    void integrate(const Atmosphere& atmosphere, double dt);
+    void advanceAscent(const Atmosphere& atmosphere, double dt);
+    void advanceFloat(const Atmosphere& atmosphere, double dt);
+    void enterQuasiSteady(const Atmosphere& atmosphere);
+    void ventExcessGas(const Atmosphere& atmosphere);
+    double calculateDragArea(double volume) const;
+
+    std::shared_ptr<GasMaterial> liftingGas;
+    double gasMass;            // kg of lifting gas in the envelope
+    double maxVolume;          // m³
+    double payloadMass;        // kg, envelope + basket + cargo
+    double dragCoefficient;    // Dimensionless, sphere ~0.47
+    double superheat;          // K
+
+    double altitude;           // m
+    double verticalVelocity;   // m/s
+    double pendingForce;       // N, external force for the next step
+
+    BalloonRegime regime;
+    int steadySteps;           // Consecutive integrated steps at terminal velocity
+
+    // Equilibrium cache, valid while quasi-steady
+    double equilibriumAltitude;
+    double settleTimeConstant;
+};
+
+/**
+ * Box-hulled boat riding the Earth's ocean surface.
+ *
+ * Buoyancy comes from a fixed grid of sample points on the hull bottom: each
+ * point stands for one column of hull and displaces water up to the local
+ * surface height, so a boat straddling a crest is partially submerged
+ * correctly. Drag acts on the velocity relative to the wave orbital velocity.
+ * Boats only translate and keep their heading; the wetted-area surface normal
+ * is reported for visual pitch and roll.
+ */
+class Boat {
+public:
+    static constexpr size_t kHullSamplesX = 4;   // Along the length
+    static constexpr size_t kHullSamplesY = 3;   // Across the beam
+    static constexpr size_t kHullSampleCount = kHullSamplesX * kHullSamplesY;
+
+    Boat(double length, double beam, double height, double mass);
+
+    // State; position is the centre of the hull box
+    const Vector3& getPosition() const { return position; }
+    void setPosition(const Vector3& value) { position = value; }
+
+    const Vector3& getVelocity() const { return velocity; }
+    void setVelocity(const Vector3& value) { velocity = value; }
+
+    double getHeading() const { return heading; }   // rad, from +x towards +y
+    void setHeading(double value) { heading = value; }
+
+    // Properties
+    double getLength() const { return length; }
+    double getBeam() const { return beam; }
+    double getHeight() const { return height; }
+    double getMass() const { return mass; }
+
+    double getDragCoefficient() const { return dragCoefficient; }
+    void setDragCoefficient(double value) { dragCoefficient = value; }
+
+    // Results of the last step
+    double getSubmergedVolume() const { return submergedVolume; }   // m³
+    const Vector3& getSurfaceNormal() const { return surfaceNormal; }
+
+    void applyForce(const Vector3& force) { pendingForce += force; }
+
+    // World-space hull sample points, kHullSampleCount of them
+    void getHullPoints(Vector3* points) const;
+
+    // Advance by dt from ocean samples taken at getHullPoints()
+    void step(const OceanSample* samples, double liquidDensity, double dt);
+    void step(const OceanSurface& ocean, double dt);
+
+    // Advance many boats in parallel, one batched ocean query per boat
+    static void stepFleet(Boat* boats, size_t count, const OceanSurface& ocean, double dt, ThreadPool& pool);
+
+private:
+    double length;             // m, along the heading
+    double beam;               // m, across
+    double height;             // m, keel to deck
+    double mass;               // kg
+    double dragCoefficient;    // Dimensionless, applied to the wetted plan area
+
+    Vector3 position;          // m
+    Vector3 velocity;          // m/s
+    double heading;            // rad
+    Vector3 pendingForce;      // N, external force for the next step
+
+    double submergedVolume;
+    Vector3 surfaceNormal;
+};
+
+} // namespace archimedes3d
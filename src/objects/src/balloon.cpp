@@ -0,0 +1,247 @@
+#include "../include/objects.h"
+#include "../../environment/include/atmosphere.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace archimedes3d {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+// Quasi-steady detection
+constexpr int kSteadySteps = 8;                 // Integrated steps at terminal velocity before switching
+constexpr double kSteadyRelativeTolerance = 0.01;
+constexpr double kSteadyAbsoluteTolerance = 0.01;   // m/s
+
+// Analytic ascent and settling
+constexpr double kSettleDistance = 25.0;        // m, below this the balloon settles exponentially
+constexpr double kSettleSpeed = 1.0e-3;         // m/s, floor for the settling rate
+constexpr double kMaxAscentStride = 200.0;      // m per analytic substep
+constexpr double kFloatSnap = 1.0e-3;           // m
+constexpr double kSearchStride = 100.0;         // m, first bracket step of the equilibrium search
+constexpr double kForceTolerance = 1.0e-9;      // Net force treated as balanced, relative to payload weight
+
+} // namespace
+
+Balloon::Balloon(std::shared_ptr<GasMaterial> liftingGas, double gasMass, double maxVolume, double payloadMass)
+    : liftingGas(std::move(liftingGas))
+    , gasMass(gasMass)
+    , maxVolume(maxVolume)
+    , payloadMass(payloadMass)
+    , dragCoefficient(0.47)   // Sphere
+    , superheat(0.0)
+    , altitude(0.0)
+    , verticalVelocity(0.0)
+    , pendingForce(0.0)
+    , regime(BalloonRegime::Integrating)
+    , steadySteps(0)
+    , equilibriumAltitude(0.0)
+    , settleTimeConstant(0.0)
+{
+}
+
+double Balloon::calculateGasDensity(const Atmosphere& atmosphere, double altitude) const {
+    // Registry densities are at sea-level reference conditions; scale with
+    // pressure and with temperature through the material's expansion coefficient
+    const double pressureRatio = atmosphere.getPressure(altitude) / Atmosphere::kSeaLevelPressure;
+    const double gasTemperature = atmosphere.getTemperature(altitude) + superheat;
+    const double beta = liftingGas->getExpansionCoefficient();
+
+    const double expansion = beta > 0.0
+        ? 1.0 + beta * (gasTemperature - Atmosphere::kSeaLevelTemperature)
+        : gasTemperature / Atmosphere::kSeaLevelTemperature;
+
+    return liftingGas->getDensity() * pressureRatio / expansion;
+}
+
+double Balloon::calculateVolume(const Atmosphere& atmosphere, double altitude) const {
+    return std::min(gasMass / calculateGasDensity(atmosphere, altitude), maxVolume);
+}
+
+double Balloon::calculateStaticForce(const Atmosphere& atmosphere, double altitude) const {
+    // Archimedes: F = (ρ_air·V - m_gas - m_payload)·g, with gas beyond a full envelope vented
+    const double gasDensity = calculateGasDensity(atmosphere, altitude);
+    const double volume = std::min(gasMass / gasDensity, maxVolume);
+    const double containedGas = std::min(gasMass, gasDensity * maxVolume);
+    const double airDensity = atmosphere.getDensity(altitude);
+    return (airDensity * volume - containedGas - payloadMass) * Atmosphere::kGravity;
+}
+
+double Balloon::calculateDragArea(double volume) const {
+    const double radius = std::cbrt(3.0 * volume / (4.0 * kPi));
+    return kPi * radius * radius;
+}
+
+double Balloon::calculateTerminalVelocity(const Atmosphere& atmosphere, double altitude) const {
+    // Static force balanced by quadratic drag: F = ½·ρ·Cd·A·v²
+    const double force = calculateStaticForce(atmosphere, altitude);
+    const double area = calculateDragArea(calculateVolume(atmosphere, altitude));
+    const double dragFactor = 0.5 * atmosphere.getDensity(altitude) * dragCoefficient * area;
+    if (dragFactor <= 0.0) return 0.0;
+
+    const double speed = std::sqrt(std::abs(force) / dragFactor);
+    return force >= 0.0 ? speed : -speed;
+}
+
+double Balloon::calculateEquilibriumAltitude(const Atmosphere& atmosphere) const {
+    // Walk from the current altitude along the net force until it changes sign,
+    // then bisect: the nearest root is the one the balloon will actually reach
+    const double force = calculateStaticForce(atmosphere, altitude);
+    if (std::abs(force) <= kForceTolerance * payloadMass * Atmosphere::kGravity) return altitude;
+
+    const double direction = force > 0.0 ? 1.0 : -1.0;
+    double inside = altitude;
+    double outside = altitude;
+    double stride = kSearchStride;
+
+    while (true) {
+        outside = std::clamp(inside + direction * stride, 0.0, Atmosphere::kCeiling);
+        if (calculateStaticForce(atmosphere, outside) * direction <= 0.0) break;
+        if (outside == 0.0 || outside == Atmosphere::kCeiling) return outside;
+        inside = outside;
+        stride *= 2.0;
+    }
+
+    for (int i = 0; i < 40; ++i) {
+        const double middle = 0.5 * (inside + outside);
+        if (calculateStaticForce(atmosphere, middle) * direction > 0.0) {
+            inside = middle;
+        } else {
+            outside = middle;
+        }
+    }
+    return 0.5 * (inside + outside);
+}
+
+void Balloon::applyForce(double force) {
+    pendingForce += force;
+    disturb();
+}
+
+void Balloon::applyImpulse(double impulse) {
+    verticalVelocity += impulse / (payloadMass + gasMass);
+    disturb();
+}
+
+void Balloon::disturb() {
+    regime = BalloonRegime::Integrating;
+    steadySteps = 0;
+}
+
+void Balloon::ventExcessGas(const Atmosphere& atmosphere) {
+    gasMass = std::min(gasMass, calculateGasDensity(atmosphere, altitude) * maxVolume);
+}
+
+void Balloon::step(const Atmosphere& atmosphere, double dt) {
+    switch (regime) {
+        case BalloonRegime::Integrating:
+            integrate(atmosphere, dt);
+            break;
+        case BalloonRegime::Ascending:
+            advanceAscent(atmosphere, dt);
+            break;
+        case BalloonRegime::Floating:
+            advanceFloat(atmosphere, dt);
+            break;
+    }
+}
+
+void Balloon::integrate(const Atmosphere& atmosphere, double dt) {
+    const bool externallyDriven = pendingForce != 0.0;
+
+    const double gasDensity = calculateGasDensity(atmosphere, altitude);
+    const double mass = payloadMass + std::min(gasMass, gasDensity * maxVolume);
+    const double force = calculateStaticForce(atmosphere, altitude) + pendingForce;
+    const double area = calculateDragArea(std::min(gasMass / gasDensity, maxVolume));
+    const double dragFactor = 0.5 * atmosphere.getDensity(altitude) * dragCoefficient * area;
+    pendingForce = 0.0;
+
+    // Implicit quadratic drag: v' + c·v'|v'| = b, stable for any dt
+    const double b = verticalVelocity + force / mass * dt;
+    const double c = dragFactor * dt / mass;
+    if (c > 0.0) {
+        const double root = (std::sqrt(1.0 + 4.0 * c * std::abs(b)) - 1.0) / (2.0 * c);
+        verticalVelocity = b >= 0.0 ? root : -root;
+    } else {
+        verticalVelocity = b;
+    }
+
+    altitude += verticalVelocity * dt;
+    if (altitude <= 0.0) {
+        altitude = 0.0;
+        verticalVelocity = std::max(verticalVelocity, 0.0);
+    }
+    ventExcessGas(atmosphere);
+
+    // Quasi-steady once velocity has matched terminal velocity for a while
+    const double terminal = calculateTerminalVelocity(atmosphere, altitude);
+    const bool grounded = altitude <= 0.0 && terminal <= 0.0;
+    const bool atTerminal = std::abs(verticalVelocity - terminal) <=
+        kSteadyRelativeTolerance * std::abs(terminal) + kSteadyAbsoluteTolerance;
+
+    steadySteps = (!externallyDriven && (grounded || atTerminal)) ? steadySteps + 1 : 0;
+    if (steadySteps >= kSteadySteps) {
+        enterQuasiSteady(atmosphere);
+    }
+}
+
+void Balloon::enterQuasiSteady(const Atmosphere& atmosphere) {
+    equilibriumAltitude = calculateEquilibriumAltitude(atmosphere);
+
+    const double distance = std::abs(altitude - equilibriumAltitude);
+    const double terminal = calculateTerminalVelocity(atmosphere, altitude);
+
+    if (distance <= kSettleDistance) {
+        regime = BalloonRegime::Floating;
+        settleTimeConstant = std::max(distance, kFloatSnap) / std::max(std::abs(terminal), kSettleSpeed);
+    } else {
+        regime = BalloonRegime::Ascending;
+    }
+}
+
+void Balloon::advanceAscent(const Atmosphere& atmosphere, double dt) {
+    // dh/dt = v_t(h), midpoint rule in strides short enough for v_t to vary smoothly
+    double remaining = dt;
+    while (remaining > 0.0) {
+        const double terminal = calculateTerminalVelocity(atmosphere, altitude);
+        const double stride = std::abs(terminal) > 0.0
+            ? std::min(remaining, kMaxAscentStride / std::abs(terminal))
+            : remaining;
+
+        const double midpoint = altitude + 0.5 * stride * terminal;
+        const double previous = altitude;
+        altitude += stride * calculateTerminalVelocity(atmosphere, midpoint);
+        remaining -= stride;
+        ventExcessGas(atmosphere);
+
+        // Hand over to settling near (or on crossing) the equilibrium altitude.
+        // Venting can move the equilibrium, so re-solve if we are heading away from it
+        const bool crossed = (previous - equilibriumAltitude) * (altitude - equilibriumAltitude) <= 0.0;
+        const bool receding = (altitude - previous) * (equilibriumAltitude - altitude) < 0.0;
+        if (crossed || receding || std::abs(altitude - equilibriumAltitude) <= kSettleDistance) {
+            if (crossed) altitude = equilibriumAltitude;
+            enterQuasiSteady(atmosphere);
+            if (regime == BalloonRegime::Floating) {
+                advanceFloat(atmosphere, remaining);
+                return;
+            }
+        }
+    }
+    verticalVelocity = calculateTerminalVelocity(atmosphere, altitude);
+}
+
+void Balloon::advanceFloat(const Atmosphere& atmosphere, double dt) {
+    // Exponential approach: h(t) = h_eq + (h0 - h_eq)·e^(-t/τ)
+    double offset = altitude - equilibriumAltitude;
+    if (offset != 0.0) {
+        offset *= std::exp(-dt / settleTimeConstant);
+        if (std::abs(offset) < kFloatSnap) offset = 0.0;
+        altitude = equilibriumAltitude + offset;
+        ventExcessGas(atmosphere);
+    }
+    verticalVelocity = -offset / settleTimeConstant;
+}
+
+} // namespace archimedes3d
@@ -0,0 +1,108 @@
+#include "../include/objects.h"
+#include "../../core/include/thread_pool.h"
+#include "../../environment/include/earth.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace archimedes3d {
+
+namespace {
+
+constexpr size_t kFleetGrain = 64;    // Boats per parallel chunk
+constexpr double kHeaveDamping = 0.2; // Damping ratio standing in for wave radiation
+
+} // namespace
+
+Boat::Boat(double length, double beam, double height, double mass)
+    : length(length)
+    , beam(beam)
+    , height(height)
+    , mass(mass)
+    , dragCoefficient(0.8)
+    , heading(0.0)
+    , submergedVolume(0.0)
+    , surfaceNormal(0.0, 0.0, 1.0)
+{
+}
+
+void Boat::getHullPoints(Vector3* points) const {
+    const double c = std::cos(heading);
+    const double s = std::sin(heading);
+    const double keel = position.z - 0.5 * height;
+
+    for (size_t i = 0; i < kHullSamplesX; ++i) {
+        const double along = ((double(i) + 0.5) / double(kHullSamplesX) - 0.5) * length;
+        for (size_t j = 0; j < kHullSamplesY; ++j) {
+            const double across = ((double(j) + 0.5) / double(kHullSamplesY) - 0.5) * beam;
+            points[i * kHullSamplesY + j] = Vector3(position.x + along * c - across * s,
+                                                    position.y + along * s + across * c,
+                                                    keel);
+        }
+    }
+}
+
+void Boat::step(const OceanSample* samples, double liquidDensity, double dt) {
+    const double keel = position.z - 0.5 * height;
+    const double planArea = length * beam;
+    const double columnArea = planArea / double(kHullSampleCount);
+
+    // Each sample displaces the column of water between the keel and the
+    // local surface, capped at the deck
+    double wetDepth = 0.0;
+    size_t piercing = 0;   // Samples where the surface cuts the hull side
+    Vector3 waterVelocity;
+    Vector3 normal;
+    for (size_t i = 0; i < kHullSampleCount; ++i) {
+        const double depth = std::min(std::max(samples[i].height - keel, 0.0), height);
+        wetDepth += depth;
+        piercing += depth > 0.0 && depth < height;
+        waterVelocity += samples[i].velocity * depth;
+        normal += samples[i].normal * depth;
+    }
+
+    submergedVolume = wetDepth * columnArea;
+    if (wetDepth > 0.0) {
+        waterVelocity /= wetDepth;
+        surfaceNormal = normal.normalized();
+    } else {
+        surfaceNormal = Vector3(0.0, 0.0, 1.0);
+    }
+
+    const double g = Earth::kGravity;
+    const Vector3 force = pendingForce + Vector3(0.0, 0.0, (liquidDensity * submergedVolume - mass) * g);
+    pendingForce = Vector3();
+    velocity += force * (dt / mass);
+
+    // Quadratic drag against the orbital flow on the wetted part of the hull,
+    // linearised implicitly so it cannot overshoot
+    const double wettedFraction = submergedVolume / (planArea * height);
+    const double drag = 0.5 * liquidDensity * dragCoefficient * planArea * wettedFraction / mass;
+    Vector3 relative = velocity - waterVelocity;
+    relative /= 1.0 + drag * relative.length() * dt;
+
+    // Heave: stiffness ρ·g·A_waterplane, damped at a fixed ratio of critical
+    const double stiffness = liquidDensity * g * columnArea * double(piercing);
+    relative.z /= 1.0 + 2.0 * kHeaveDamping * std::sqrt(stiffness / mass) * dt;
+    velocity = waterVelocity + relative;
+
+    position += velocity * dt;
+}
+
+void Boat::step(const OceanSurface& ocean, double dt) {
+    Vector3 points[kHullSampleCount];
+    OceanSample samples[kHullSampleCount];
+    getHullPoints(points);
+    ocean.sample(points, kHullSampleCount, samples);
+    step(samples, ocean.getDensity(), dt);
+}
+
+void Boat::stepFleet(Boat* boats, size_t count, const OceanSurface& ocean, double dt, ThreadPool& pool) {
+    pool.parallelFor(count, kFleetGrain, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            boats[i].step(ocean, dt);
+        }
+    });
+}
+
+} // namespace archimedes3d
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace archimedes3d {
+
+// Forward declarations
+class World;
+using BodyId = uint32_t;
+
+/**
+ * Archimedes' principle: the only "gravity" a body feels is the difference
+ * between its density and that of the medium it displaces
+ */
+class Buoyancy {
+public:
+    // Net vertical force (positive = up): F = (ρ_medium - ρ_body)·V·g
+    static constexpr double calculateNetForce(double mediumDensity, double bodyDensity, double volume, double gravity) {
+        return (mediumDensity - bodyDensity) * volume * gravity;
+    }
+    // Single precision, for the region-local integration kernels
+    static constexpr float calculateNetForce(float mediumDensity, float bodyDensity, float volume, float gravity) {
+        return (mediumDensity - bodyDensity) * volume * gravity;
+    }
+
+    // Medium density around each awake body in [begin, end)
+    static void sampleMedium(const World& world, size_t begin, size_t end, float* mediumDensities);
+    // The same for a list of bodies; results are still indexed by body id
+    static void sampleMediumList(const World& world, const BodyId* bodies, size_t count, float* mediumDensities);
+};
+
+} // namespace archimedes3d
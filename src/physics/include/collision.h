@@ -0,0 +1,125 @@
+#pragma once
+
+#include "../../math/include/vectors.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace archimedes3d {
+
+/**
+ * Spatial hash over bounding spheres, the acceleration structure behind
+ * collision detection and spatial queries.
+ *
+ * Each sphere is filed under the cell containing its centre; cells are at
+ * least one sphere diameter wide, so a sphere can only reach into the 27
+ * cells around its own. Cells hash into a power-of-two bucket table sorted by
+ * a counting sort, so a rebuild is O(n) and, once the arrays have grown,
+ * allocation-free. The structure keeps pointers to the caller's position and
+ * radius arrays, which must outlive it and stay unchanged until the next build.
+ */
+class BroadPhase {
+public:
+    static constexpr uint32_t kNone = 0xffffffff;
+
+    // cellSize is raised to at least the largest diameter; 0 uses exactly that
+    void build(const Vector3* positions, const double* radii, size_t count, double cellSize = 0.0);
+
+    size_t getCount() const { return entries.size(); }
+    double getCellSize() const { return cellSize; }
+    double getMaxRadius() const { return maxRadius; }
+
+    // Bounds of all spheres (empty when min > max)
+    const Vector3& getBoundsMin() const { return boundsMin; }
+    const Vector3& getBoundsMax() const { return boundsMax; }
+
+    // visitor(index) once for every sphere overlapping the box [min, max]
+    template <typename Visitor>
+    void forEachOverlapping(const Vector3& min, const Vector3& max, Visitor&& visitor) const;
+
+    // Nearest sphere hit by the ray within maxDistance, or kNone; a ray
+    // starting inside a sphere hits it at distance 0
+    uint32_t raycast(const Vector3& origin, const Vector3& direction, double maxDistance,
+                     double& distance) const;
+
+private:
+    struct Entry {
+        int32_t x, y, z;   // Cell of the sphere's centre
+        uint32_t index;
+    };
+
+    int32_t cellOf(double coordinate) const {
+        return static_cast<int32_t>(std::floor(coordinate * inverseCellSize));
+    }
+
+    size_t bucketOf(int32_t x, int32_t y, int32_t z) const {
+        const uint32_t hash = (uint32_t(x) * 73856093u) ^ (uint32_t(y) * 19349663u) ^ (uint32_t(z) * 83492791u);
+        return hash & bucketMask;
+    }
+
+    static bool overlapsBox(const Vector3& center, double radius, const Vector3& min, const Vector3& max) {
+        const double dx = center.x - std::min(std::max(center.x, min.x), max.x);
+        const double dy = center.y - std::min(std::max(center.y, min.y), max.y);
+        const double dz = center.z - std::min(std::max(center.z, min.z), max.z);
+        return dx * dx + dy * dy + dz * dz <= radius * radius;
+    }
+
+    const Vector3* positions = nullptr;
+    const double* radii = nullptr;
+
+    double cellSize = 1.0;
+    double inverseCellSize = 1.0;
+    double maxRadius = 0.0;
+    Vector3 boundsMin{1.0, 1.0, 1.0};
+    Vector3 boundsMax{0.0, 0.0, 0.0};
+
+    size_t bucketMask = 0;
+    std::vector<uint32_t> bucketStart;   // bucketMask + 2 offsets into entries
+    std::vector<Entry> entries;          // Sorted by bucket
+    std::vector<Entry> unsorted;         // Build scratch
+};
+
+template <typename Visitor>
+void BroadPhase::forEachOverlapping(const Vector3& min, const Vector3& max, Visitor&& visitor) const {
+    if (entries.empty()) return;
+
+    // Centres of overlapping spheres lie in the box grown by the largest radius
+    const Vector3 grow(maxRadius, maxRadius, maxRadius);
+    const Vector3 low = min - grow;
+    const Vector3 high = max + grow;
+    if (low.x > boundsMax.x || low.y > boundsMax.y || low.z > boundsMax.z ||
+        high.x < boundsMin.x || high.y < boundsMin.y || high.z < boundsMin.z) {
+        return;
+    }
+
+    const int32_t x0 = cellOf(std::max(low.x, boundsMin.x)), x1 = cellOf(std::min(high.x, boundsMax.x));
+    const int32_t y0 = cellOf(std::max(low.y, boundsMin.y)), y1 = cellOf(std::min(high.y, boundsMax.y));
+    const int32_t z0 = cellOf(std::max(low.z, boundsMin.z)), z1 = cellOf(std::min(high.z, boundsMax.z));
+    const double cells = double(x1 - x0 + 1) * double(y1 - y0 + 1) * double(z1 - z0 + 1);
+
+    // A box covering more cells than there are spheres is cheaper to scan linearly
+    if (cells > double(entries.size())) {
+        for (const Entry& entry : entries) {
+            if (overlapsBox(positions[entry.index], radii[entry.index], min, max)) visitor(entry.index);
+        }
+        return;
+    }
+
+    for (int32_t z = z0; z <= z1; ++z) {
+        for (int32_t y = y0; y <= y1; ++y) {
+            for (int32_t x = x0; x <= x1; ++x) {
+                const size_t bucket = bucketOf(x, y, z);
+                for (uint32_t e = bucketStart[bucket]; e < bucketStart[bucket + 1]; ++e) {
+                    const Entry& entry = entries[e];
+                    // Buckets are shared by colliding cells; keep only this cell's spheres
+                    if (entry.x != x || entry.y != y || entry.z != z) continue;
+                    if (overlapsBox(positions[entry.index], radii[entry.index], min, max)) visitor(entry.index);
+                }
+            }
+        }
+    }
+}
+
+} // namespace archimedes3d
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace archimedes3d {
+
+// Forward declarations
+class World;
+using BodyId = uint32_t;
+
+/**
+ * Parameters of body integration
+ */
+struct MotionSettings {
+    double gravity = 9.80665;         // m/s², acting along -z
+    double dragCoefficient = 0.47;    // Sphere
+    double groundHeight = 0.0;        // m, z of the ground plane
+    double groundRestitution = 0.2;
+    double sleepSpeed = 1.0e-3;       // m/s
+    uint16_t sleepSteps = 60;         // Slow steps before a body sleeps
+};
+
+/**
+ * Body integration kernels, applied to index ranges so phases can be split
+ * across threads.
+ *
+ * integrate() is branch-free over the World's float streams and vectorises
+ * across bodies at -O3. The drag term's square root keeps an errno branch
+ * unless the build also passes -fno-math-errno (or -ffast-math).
+ */
+class Motion {
+public:
+    // Buoyancy, external forces and implicit quadratic drag, then ground contact.
+    // Works on the float region-local state and moves bodies that leave their
+    // region into an existing one; returns how many found no region and need
+    // World::rebaseBodies() with region creation
+    static size_t integrate(World& world, size_t begin, size_t end, const float* mediumDensities,
+                            double dt, const MotionSettings& settings);
+    // The same for a list of bodies (multi-rate substeps). External forces stay
+    // applied for every substep; the caller clears them once the step is done
+    static size_t integrateList(World& world, const BodyId* bodies, size_t count, const float* mediumDensities,
+                                double dt, const MotionSettings& settings);
+
+    // Advance sleep counters; returns how many bodies in the range are asleep
+    static size_t updateSleeping(World& world, size_t begin, size_t end, const MotionSettings& settings);
+};
+
+} // namespace archimedes3d
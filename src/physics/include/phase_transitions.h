@@ -0,0 +1,118 @@
+#pragma once
+
+#include "../../core/include/world.h"
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace archimedes3d {
+
+/**
+ * One material change at a temperature threshold
+ */
+struct PhaseRule {
+    MaterialId from;
+    MaterialId to;
+    double threshold;   // K
+    bool rising;        // true: from → to once T ≥ threshold; false: once T ≤ threshold
+};
+
+/**
+ * Tunable parameters of the phase-transition subsystem
+ */
+struct PhaseSettings {
+    double heatTransferCoefficient = 25.0;   // W/(m²·K), convection between a body and its medium
+    double hysteresis = 0.5;                 // K, gap between a built-in transition and its reverse
+    double maxEventHorizon = 1.0;            // s, longest a tracked entry goes without a re-check
+    bool conserveMass = true;                // Bodies keep their mass and change volume
+};
+
+/**
+ * Event-driven material changes of bodies and voxels at temperature thresholds
+ * (melting, freezing, boiling, condensing, ionising).
+ *
+ * Temperatures follow Newtonian relaxation towards a target, so the time at
+ * which an entry reaches its next threshold is known in closed form. Bodies
+ * relax towards the medium around them (time constant m·c / (h·A)); voxels
+ * only change temperature while heated through heatVoxel(). Every tracked
+ * entry sits in a priority queue keyed by that time (capped at
+ * maxEventHorizon, so moving bodies see their new surroundings and the grid
+ * temperatures of heating voxels stay current), and update()
+ * only touches entries that are due. Bodies whose material has no rules are
+ * not queued at all, so add rules before tracking. Transitions found in one update are
+ * applied together: body material ids and densities in place, voxels through
+ * a single copy-on-write edit of the medium grid. Latent heat is ignored.
+ */
+class PhaseTransitions {
+public:
+    explicit PhaseTransitions(const PhaseSettings& settings = PhaseSettings());
+
+    // Rules
+    void addRule(const PhaseRule& rule);
+    // Ice ↔ water (at water's freezing point), water ↔ steam, liquid nitrogen ↔
+    // nitrogen, air ↔ ionized air; pairs missing from the table are skipped
+    void addBuiltinRules(const MaterialTable& materials);
+
+    // Start (or, after an external change, restart) tracking from the current state
+    void trackBodies(const World& world);
+    void trackBody(const World& world, BodyId id);
+
+    // Relax a voxel towards targetTemperature with the given time constant
+    void heatVoxel(const World& world, size_t cell, double targetTemperature, double timeConstant);
+
+    // Process every entry due by world.getTime(); returns the transitions applied
+    size_t update(World& world);
+
+    // Temperature now, between events
+    double getBodyTemperature(const World& world, BodyId id) const;
+    double getVoxelTemperature(const World& world, size_t cell) const;
+
+    const PhaseSettings& getSettings() const { return settings; }
+    size_t getLastCheckCount() const { return lastChecks; }
+
+private:
+    // Relaxation state since the last check: T(t) = target + (T_ref - target)·e^(-(t - t_ref)/τ)
+    struct Thermal {
+        double referenceTime = 0.0;
+        double referenceTemperature = 0.0;
+        double target = 0.0;
+        double timeConstant = 0.0;   // s; 0 = constant temperature
+        uint32_t version = 0;        // Matches the live queue entry
+    };
+
+    struct Event {
+        double time;
+        uint32_t index;     // Body id or voxel cell
+        uint32_t version;
+        bool operator>(const Event& other) const { return time > other.time; }
+    };
+
+    using EventQueue = std::priority_queue<Event, std::vector<Event>, std::greater<Event>>;
+
+    static double relax(const Thermal& thermal, double time);
+    const PhaseRule* findTriggered(MaterialId material, double temperature) const;
+    double estimateDelay(MaterialId material, const Thermal& thermal) const;
+
+    void scheduleBody(const World& world, BodyId id, double temperature);
+    void scheduleVoxel(const World& world, size_t cell, double temperature);
+
+    PhaseSettings settings;
+    std::vector<std::vector<PhaseRule>> rulesFrom;   // Indexed by source material
+
+    std::vector<Thermal> bodies;
+    std::unordered_map<size_t, Thermal> voxels;      // Heated voxels only
+    EventQueue bodyEvents;
+    EventQueue voxelEvents;
+
+    // Batched transitions of one update, reused
+    std::vector<std::pair<BodyId, MaterialId>> bodySwaps;
+    std::vector<std::pair<size_t, MaterialId>> voxelSwaps;
+    std::vector<std::pair<size_t, double>> voxelTemperatures;
+
+    size_t lastChecks = 0;
+};
+
+} // namespace archimedes3d
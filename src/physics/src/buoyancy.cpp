@@ -0,0 +1,26 @@
+#include "../include/buoyancy.h"
+#include "../../core/include/world.h"
+
+namespace archimedes3d {
+
+void Buoyancy::sampleMedium(const World& world, size_t begin, size_t end, float* mediumDensities) {
+    const uint8_t* sleeping = world.getSleeping();
+
+    for (size_t i = begin; i < end; ++i) {
+        if (sleeping[i]) continue;
+        const Vector3 position = world.getPosition(static_cast<BodyId>(i));
+        mediumDensities[i] = static_cast<float>(world.sampleMediumDensity(position));
+    }
+}
+
+void Buoyancy::sampleMediumList(const World& world, const BodyId* bodies, size_t count, float* mediumDensities) {
+    const uint8_t* sleeping = world.getSleeping();
+
+    for (size_t k = 0; k < count; ++k) {
+        const BodyId i = bodies[k];
+        if (sleeping[i]) continue;
+        mediumDensities[i] = static_cast<float>(world.sampleMediumDensity(world.getPosition(i)));
+    }
+}
+
+} // namespace archimedes3d
@@ -0,0 +1,177 @@
+#include "../include/collision.h"
+#include "../../core/include/profiler.h"
+#include "../../math/include/numerical.h"
+
+#include <limits>
+
+namespace archimedes3d {
+
+namespace {
+
+constexpr double kMinCellSize = 1.0e-3;   // m, guards against point-sized bodies
+
+} // namespace
+
+void BroadPhase::build(const Vector3* positions, const double* radii, size_t count, double cellSize) {
+    ARCHIMEDES3D_PROFILE_SCOPE("broadphase build");
+    this->positions = positions;
+    this->radii = radii;
+
+    maxRadius = 0.0;
+    boundsMin = Vector3(1.0, 1.0, 1.0);
+    boundsMax = Vector3(0.0, 0.0, 0.0);
+    if (count > 0) {
+        const double inf = std::numeric_limits<double>::infinity();
+        boundsMin = Vector3(inf, inf, inf);
+        boundsMax = Vector3(-inf, -inf, -inf);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        const double r = radii[i];
+        maxRadius = std::max(maxRadius, r);
+        boundsMin = Vector3(std::min(boundsMin.x, positions[i].x - r),
+                            std::min(boundsMin.y, positions[i].y - r),
+                            std::min(boundsMin.z, positions[i].z - r));
+        boundsMax = Vector3(std::max(boundsMax.x, positions[i].x + r),
+                            std::max(boundsMax.y, positions[i].y + r),
+                            std::max(boundsMax.z, positions[i].z + r));
+    }
+
+    this->cellSize = std::max({cellSize, 2.0 * maxRadius, kMinCellSize});
+    inverseCellSize = 1.0 / this->cellSize;
+
+    // Counting sort of the spheres into ~2 buckets per sphere
+    const size_t buckets = nextPowerOfTwo(std::max<size_t>(2 * count, 16));
+    bucketMask = buckets - 1;
+    bucketStart.assign(buckets + 1, 0);
+    unsorted.resize(count);
+    entries.resize(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        Entry& entry = unsorted[i];
+        entry.x = cellOf(positions[i].x);
+        entry.y = cellOf(positions[i].y);
+        entry.z = cellOf(positions[i].z);
+        entry.index = static_cast<uint32_t>(i);
+        ++bucketStart[bucketOf(entry.x, entry.y, entry.z) + 1];
+    }
+    for (size_t b = 0; b < buckets; ++b) {
+        bucketStart[b + 1] += bucketStart[b];
+    }
+    for (const Entry& entry : unsorted) {
+        // bucketStart[b] is used as the insertion cursor and ends at the bucket's end...
+        entries[bucketStart[bucketOf(entry.x, entry.y, entry.z)]++] = entry;
+    }
+    // ...so shifting right by one restores the starts
+    for (size_t b = buckets; b > 0; --b) {
+        bucketStart[b] = bucketStart[b - 1];
+    }
+    bucketStart[0] = 0;
+}
+
+uint32_t BroadPhase::raycast(const Vector3& origin, const Vector3& direction, double maxDistance,
+                             double& distance) const {
+    const double length = direction.length();
+    if (entries.empty() || length <= 0.0) return kNone;
+    const Vector3 d = direction / length;
+
+    // Clip the ray to the bounds of all spheres (slab test)
+    double tEnter = 0.0;
+    double tExit = maxDistance;
+    const double o[3] = {origin.x, origin.y, origin.z};
+    const double v[3] = {d.x, d.y, d.z};
+    const double lo[3] = {boundsMin.x, boundsMin.y, boundsMin.z};
+    const double hi[3] = {boundsMax.x, boundsMax.y, boundsMax.z};
+    for (int axis = 0; axis < 3; ++axis) {
+        if (v[axis] == 0.0) {
+            if (o[axis] < lo[axis] || o[axis] > hi[axis]) return kNone;
+            continue;
+        }
+        double t0 = (lo[axis] - o[axis]) / v[axis];
+        double t1 = (hi[axis] - o[axis]) / v[axis];
+        if (t0 > t1) std::swap(t0, t1);
+        tEnter = std::max(tEnter, t0);
+        tExit = std::min(tExit, t1);
+    }
+    if (tEnter > tExit) return kNone;
+
+    // 3D DDA through the cells the clipped ray crosses. A sphere hit at t has
+    // its centre within maxRadius (at most one cell) of the point at t, so
+    // testing the cells around each visited piece of the ray finds it no later
+    // than the cell containing that point
+    const Vector3 start = origin + d * tEnter;
+    int32_t cell[3] = {cellOf(start.x), cellOf(start.y), cellOf(start.z)};
+    int32_t stepDirection[3];
+    double tNext[3];
+    double tDelta[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        const double position = o[axis] + v[axis] * tEnter;
+        if (v[axis] > 0.0) {
+            stepDirection[axis] = 1;
+            tNext[axis] = tEnter + ((cell[axis] + 1) * cellSize - position) / v[axis];
+            tDelta[axis] = cellSize / v[axis];
+        } else if (v[axis] < 0.0) {
+            stepDirection[axis] = -1;
+            tNext[axis] = tEnter + (cell[axis] * cellSize - position) / v[axis];
+            tDelta[axis] = -cellSize / v[axis];
+        } else {
+            stepDirection[axis] = 0;
+            tNext[axis] = std::numeric_limits<double>::infinity();
+            tDelta[axis] = std::numeric_limits<double>::infinity();
+        }
+    }
+
+    uint32_t best = kNone;
+    double bestDistance = maxDistance;
+    double tCell = tEnter;
+
+    while (tCell <= tExit && tCell <= bestDistance) {
+        // Only neighbours within the largest radius of this cell's piece of the ray
+        const double tLeave = std::min({tNext[0], tNext[1], tNext[2], tExit});
+        const Vector3 p0 = origin + d * tCell;
+        const Vector3 p1 = origin + d * tLeave;
+        const int32_t x0 = cellOf(std::min(p0.x, p1.x) - maxRadius), x1 = cellOf(std::max(p0.x, p1.x) + maxRadius);
+        const int32_t y0 = cellOf(std::min(p0.y, p1.y) - maxRadius), y1 = cellOf(std::max(p0.y, p1.y) + maxRadius);
+        const int32_t z0 = cellOf(std::min(p0.z, p1.z) - maxRadius), z1 = cellOf(std::max(p0.z, p1.z) + maxRadius);
+
+        for (int32_t z = std::max(z0, cell[2] - 1); z <= std::min(z1, cell[2] + 1); ++z) {
+            for (int32_t y = std::max(y0, cell[1] - 1); y <= std::min(y1, cell[1] + 1); ++y) {
+                for (int32_t x = std::max(x0, cell[0] - 1); x <= std::min(x1, cell[0] + 1); ++x) {
+                    const size_t bucket = bucketOf(x, y, z);
+                    for (uint32_t e = bucketStart[bucket]; e < bucketStart[bucket + 1]; ++e) {
+                        const Entry& entry = entries[e];
+                        if (entry.x != x || entry.y != y || entry.z != z) continue;
+
+                        const Vector3 offset = positions[entry.index] - origin;
+                        const double r = radii[entry.index];
+                        const double along = offset.dot(d);
+                        const double miss = offset.lengthSquared() - along * along;
+                        if (miss > r * r) continue;
+
+                        const double half = std::sqrt(r * r - miss);
+                        double t = along - half;
+                        if (t < 0.0) {
+                            if (along + half < 0.0) continue;   // Sphere behind the origin
+                            t = 0.0;                            // Origin inside the sphere
+                        }
+                        if (t <= bestDistance) {
+                            if (t < bestDistance || entry.index < best) best = entry.index;
+                            bestDistance = t;
+                        }
+                    }
+                }
+            }
+        }
+
+        // Advance to the next cell along the ray
+        const int axis = tNext[0] < tNext[1] ? (tNext[0] < tNext[2] ? 0 : 2) : (tNext[1] < tNext[2] ? 1 : 2);
+        tCell = tNext[axis];
+        tNext[axis] += tDelta[axis];
+        cell[axis] += stepDirection[axis];
+    }
+
+    if (best != kNone) distance = bestDistance;
+    return best;
+}
+
+} // namespace archimedes3d
@@ -0,0 +1,152 @@
+#include "../include/motion.h"
+#include "../include/buoyancy.h"
+#include "../../core/include/world.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Lets the compiler vectorise a loop without proving that its arrays do not overlap
+#if defined(__clang__)
+#define ARCHIMEDES3D_INDEPENDENT_ITERATIONS _Pragma("clang loop vectorize(assume_safety)")
+#elif defined(__GNUC__)
+#define ARCHIMEDES3D_INDEPENDENT_ITERATIONS _Pragma("GCC ivdep")
+#else
+#define ARCHIMEDES3D_INDEPENDENT_ITERATIONS
+#endif
+
+namespace archimedes3d {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+// Shared loop of integrate and integrateList; bodyAt(k) is the k-th body to advance.
+// Branch-free so that over a contiguous range it vectorises: sleeping bodies
+// take a zero-length step instead of being skipped, and strays are only
+// counted here and rebased afterwards
+template <bool ClearForces, typename BodyAt>
+size_t integrateLoop(World& world, size_t count, BodyAt bodyAt, const float* mediumDensities,
+                     double dt, const MotionSettings& settings) {
+    float* positionX = world.getLocalPositions().x;
+    float* positionY = world.getLocalPositions().y;
+    float* positionZ = world.getLocalPositions().z;
+    float* velocityX = world.getVelocities().x;
+    float* velocityY = world.getVelocities().y;
+    float* velocityZ = world.getVelocities().z;
+    float* forceX = world.getForces().x;
+    float* forceY = world.getForces().y;
+    float* forceZ = world.getForces().z;
+    const uint32_t* regionIds = world.getRegionIds();
+    const float* regionHeights = world.getRegionHeights();
+    const float* volumes = world.getVolumes();
+    const float* radii = world.getRadii();
+    const float* densities = world.getDensities();
+    const uint8_t* sleeping = world.getSleeping();
+
+    // Everything below is local to the body's region, so it runs in float
+    const float timeStep = static_cast<float>(dt);
+    const float gravity = static_cast<float>(settings.gravity);
+    const float dragFactor = static_cast<float>(0.5 * kPi * settings.dragCoefficient);
+    const float groundHeight = static_cast<float>(settings.groundHeight);
+    const float restitution = static_cast<float>(settings.groundRestitution);
+    // Gravity alone pulls a resting body just under g·dt into the ground each
+    // step; impacts up to that speed are resting contact, not a bounce
+    const float restingSpeed = gravity * timeStep;
+    uint32_t strays = 0;
+
+    // Bodies are distinct, so the streams never alias across iterations
+    ARCHIMEDES3D_INDEPENDENT_ITERATIONS
+    for (size_t k = 0; k < count; ++k) {
+        const size_t i = bodyAt(k);
+        const float step = timeStep * (1.0f - float(sleeping[i]));   // Sleeping bodies stay put
+
+        const float volume = volumes[i];
+        const float density = densities[i];
+        const float mediumDensity = mediumDensities[i];
+        const float radius = radii[i];
+        const float inverseMass = 1.0f / (density * volume);
+        const float lift = Buoyancy::calculateNetForce(mediumDensity, density, volume, gravity);
+
+        float vx = velocityX[i] + forceX[i] * inverseMass * step;
+        float vy = velocityY[i] + forceY[i] * inverseMass * step;
+        float vz = velocityZ[i] + (forceZ[i] + lift) * inverseMass * step;
+        if (ClearForces) {
+            forceX[i] = 0.0f;
+            forceY[i] = 0.0f;
+            forceZ[i] = 0.0f;
+        }
+
+        // Quadratic drag F = ½·ρ·Cd·A·|v|·v, linearised implicitly so it cannot overshoot
+        const float drag = dragFactor * mediumDensity * radius * radius * inverseMass;
+        const float damping = 1.0f / (1.0f + drag * std::sqrt(vx * vx + vy * vy + vz * vz) * step);
+        vx *= damping;
+        vy *= damping;
+        vz *= damping;
+
+        const float px = positionX[i] + vx * step;
+        const float py = positionY[i] + vy * step;
+        float pz = positionZ[i] + vz * step;
+
+        // Ground plane, in the region's frame. A rising body keeps going; a falling one
+        // rebounds with the impact speed beyond restingSpeed, so a resting body stops
+        // dead and can fall asleep. Written with max alone, which keeps the loop vectorised
+        const float floor = groundHeight + radius - regionHeights[regionIds[i]];
+        const float landed = std::max(std::max(vz, 0.0f), (-vz - restingSpeed) * restitution);
+        vz = pz < floor ? landed : vz;
+        pz = std::max(pz, floor);
+
+        positionX[i] = px;
+        positionY[i] = py;
+        positionZ[i] = pz;
+        velocityX[i] = vx;
+        velocityY[i] = vy;
+        velocityZ[i] = vz;
+        strays += World::isStray(px, py, pz);
+    }
+
+    if (strays == 0) return 0;
+    size_t remaining = 0;
+    for (size_t k = 0; k < count; ++k) {
+        const size_t i = bodyAt(k);
+        remaining += world.rebaseBodies(i, i + 1, false);
+    }
+    return remaining;
+}
+
+} // namespace
+
+size_t Motion::integrate(World& world, size_t begin, size_t end, const float* mediumDensities,
+                         double dt, const MotionSettings& settings) {
+    return integrateLoop<true>(world, end - begin, [begin](size_t k) { return begin + k; },
+                               mediumDensities, dt, settings);
+}
+
+size_t Motion::integrateList(World& world, const BodyId* bodies, size_t count, const float* mediumDensities,
+                             double dt, const MotionSettings& settings) {
+    return integrateLoop<false>(world, count, [bodies](size_t k) { return size_t(bodies[k]); },
+                                mediumDensities, dt, settings);
+}
+
+size_t Motion::updateSleeping(World& world, size_t begin, size_t end, const MotionSettings& settings) {
+    const Vector3Streams<const float> velocities = static_cast<const World&>(world).getVelocities();
+    uint8_t* sleeping = world.getSleeping();
+    uint16_t* counters = world.getSleepCounters();
+    const float limit = static_cast<float>(settings.sleepSpeed * settings.sleepSpeed);
+
+    size_t asleep = 0;
+    for (size_t i = begin; i < end; ++i) {
+        if (!sleeping[i]) {
+            if (velocities.load(i).lengthSquared() < limit) {
+                if (++counters[i] >= settings.sleepSteps) {
+                    sleeping[i] = 1;
+                }
+            } else {
+                counters[i] = 0;
+            }
+        }
+        asleep += sleeping[i];
+    }
+    return asleep;
+}
+
+} // namespace archimedes3d
@@ -0,0 +1,238 @@
+#include "../include/phase_transitions.h"
+#include "../../core/include/profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace archimedes3d {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kNever = std::numeric_limits<double>::infinity();
+
+// Thresholds the material classes do not carry, K at sea-level pressure
+constexpr double kWaterBoilingPoint = 373.15;
+constexpr double kNitrogenBoilingPoint = 77.36;
+constexpr double kAirIonizationTemperature = 8000.0;   // Thermal ionisation becomes significant
+
+constexpr double kSettledTemperature = 0.01;   // K from its target, a heated voxel stops refreshing
+
+} // namespace
+
+PhaseTransitions::PhaseTransitions(const PhaseSettings& settings)
+    : settings(settings)
+{
+}
+
+void PhaseTransitions::addRule(const PhaseRule& rule) {
+    if (rule.from == kInvalidMaterial || rule.to == kInvalidMaterial) return;
+    if (rulesFrom.size() <= rule.from) rulesFrom.resize(size_t(rule.from) + 1);
+    rulesFrom[rule.from].push_back(rule);
+}
+
+void PhaseTransitions::addBuiltinRules(const MaterialTable& materials) {
+    const double half = 0.5 * settings.hysteresis;
+    auto addPair = [&](const char* lower, const char* upper, double threshold) {
+        const MaterialId low = materials.find(lower);
+        const MaterialId high = materials.find(upper);
+        if (low == kInvalidMaterial || high == kInvalidMaterial) return;
+        addRule({low, high, threshold + half, true});
+        addRule({high, low, threshold - half, false});
+    };
+
+    const MaterialId water = materials.find("water");
+    if (water != kInvalidMaterial) {
+        const auto* liquid = dynamic_cast<const LiquidMaterial*>(&materials.getMaterial(water));
+        if (liquid) addPair("ice", "water", liquid->getFreezingPoint());
+    }
+    addPair("water", "steam", kWaterBoilingPoint);
+    addPair("liquid_nitrogen", "nitrogen", kNitrogenBoilingPoint);
+    addPair("air", "ionized_air", kAirIonizationTemperature);
+}
+
+double PhaseTransitions::relax(const Thermal& thermal, double time) {
+    if (thermal.timeConstant <= 0.0) return thermal.referenceTemperature;
+    const double decay = std::exp(-(time - thermal.referenceTime) / thermal.timeConstant);
+    return thermal.target + (thermal.referenceTemperature - thermal.target) * decay;
+}
+
+const PhaseRule* PhaseTransitions::findTriggered(MaterialId material, double temperature) const {
+    if (material >= rulesFrom.size()) return nullptr;
+    for (const PhaseRule& rule : rulesFrom[material]) {
+        if (rule.rising ? temperature >= rule.threshold : temperature <= rule.threshold) return &rule;
+    }
+    return nullptr;
+}
+
+double PhaseTransitions::estimateDelay(MaterialId material, const Thermal& thermal) const {
+    if (material >= rulesFrom.size()) return kNever;
+
+    const double temperature = thermal.referenceTemperature;
+    const double target = thermal.target;
+    double delay = kNever;
+
+    for (const PhaseRule& rule : rulesFrom[material]) {
+        if (rule.rising ? temperature >= rule.threshold : temperature <= rule.threshold) return 0.0;
+        if (thermal.timeConstant <= 0.0) continue;
+
+        // Solve target + (T - target)·e^(-t/τ) = threshold, if the target lies beyond it
+        const bool reachable = rule.rising ? target > rule.threshold : target < rule.threshold;
+        if (reachable) {
+            delay = std::min(delay, thermal.timeConstant * std::log((target - temperature) / (target - rule.threshold)));
+        }
+    }
+    return delay;
+}
+
+void PhaseTransitions::trackBodies(const World& world) {
+    for (size_t id = 0; id < world.getBodyCount(); ++id) {
+        trackBody(world, static_cast<BodyId>(id));
+    }
+}
+
+void PhaseTransitions::trackBody(const World& world, BodyId id) {
+    if (bodies.size() <= id) bodies.resize(size_t(id) + 1);
+    scheduleBody(world, id, world.getTemperature(id));
+}
+
+void PhaseTransitions::heatVoxel(const World& world, size_t cell, double targetTemperature, double timeConstant) {
+    const double temperature = getVoxelTemperature(world, cell);
+    Thermal& thermal = voxels[cell];
+    thermal.target = targetTemperature;
+    thermal.timeConstant = timeConstant;
+    scheduleVoxel(world, cell, temperature);
+}
+
+void PhaseTransitions::scheduleBody(const World& world, BodyId id, double temperature) {
+    const double now = world.getTime();
+    const MaterialId material = world.getMaterial(id);
+
+    // Convection with the surrounding medium: τ = m·c / (h·A)
+    const double radius = world.getRadius(id);
+    const double area = 4.0 * kPi * radius * radius;
+    const double heatCapacity = world.getMass(id) * world.getMaterials().getSpecificHeat(material);
+
+    Thermal& thermal = bodies[id];
+    thermal.referenceTime = now;
+    thermal.referenceTemperature = temperature;
+    thermal.target = world.sampleMediumTemperature(world.getPosition(id));
+    thermal.timeConstant = area > 0.0 ? heatCapacity / (settings.heatTransferCoefficient * area) : 0.0;
+    ++thermal.version;
+
+    // A material without rules never transitions, wherever the body moves
+    if (material >= rulesFrom.size() || rulesFrom[material].empty()) return;
+
+    // Re-check at least every maxEventHorizon: the body may move into other surroundings.
+    // Events are always strictly in the future, so each update handles an entry once
+    const double delay = std::min(estimateDelay(material, thermal), settings.maxEventHorizon);
+    const double time = std::max(now + delay, std::nextafter(now, kNever));
+    bodyEvents.push({time, id, thermal.version});
+}
+
+void PhaseTransitions::scheduleVoxel(const World& world, size_t cell, double temperature) {
+    const double now = world.getTime();
+    const MediumGrid* medium = world.getMedium();
+    if (!medium || cell >= medium->getCellCount()) return;
+
+    Thermal& thermal = voxels[cell];
+    thermal.referenceTime = now;
+    thermal.referenceTemperature = temperature;
+    ++thermal.version;
+
+    // A voxel's temperature depends only on its own heating: without a
+    // reachable threshold it only needs refreshing until it has settled
+    double delay = estimateDelay(medium->getCells()[cell], thermal);
+    if (thermal.timeConstant > 0.0 && std::abs(temperature - thermal.target) > kSettledTemperature) {
+        delay = std::min(delay, settings.maxEventHorizon);
+    }
+    if (delay == kNever) return;
+    const double time = std::max(now + delay, std::nextafter(now, kNever));
+    voxelEvents.push({time, static_cast<uint32_t>(cell), thermal.version});
+}
+
+size_t PhaseTransitions::update(World& world) {
+    ARCHIMEDES3D_PROFILE_SCOPE("phase transitions");
+    const double now = world.getTime();
+    lastChecks = 0;
+    bodySwaps.clear();
+    voxelSwaps.clear();
+    voxelTemperatures.clear();
+
+    while (!bodyEvents.empty() && bodyEvents.top().time <= now) {
+        const Event event = bodyEvents.top();
+        bodyEvents.pop();
+        if (event.index >= bodies.size() || event.index >= world.getBodyCount()) continue;
+        if (bodies[event.index].version != event.version) continue;   // Superseded
+        ++lastChecks;
+
+        const BodyId id = event.index;
+        const double temperature = relax(bodies[id], now);
+        world.setTemperature(id, temperature);
+
+        if (const PhaseRule* rule = findTriggered(world.getMaterial(id), temperature)) {
+            bodySwaps.emplace_back(id, rule->to);
+        } else {
+            scheduleBody(world, id, temperature);
+        }
+    }
+
+    while (!voxelEvents.empty() && voxelEvents.top().time <= now) {
+        const Event event = voxelEvents.top();
+        voxelEvents.pop();
+        auto found = voxels.find(event.index);
+        if (found == voxels.end() || found->second.version != event.version) continue;
+        ++lastChecks;
+
+        const double temperature = relax(found->second, now);
+        voxelTemperatures.emplace_back(event.index, temperature);
+
+        const MaterialId material = world.getMedium()->getCells()[event.index];
+        if (const PhaseRule* rule = findTriggered(material, temperature)) {
+            voxelSwaps.emplace_back(event.index, rule->to);
+        } else {
+            scheduleVoxel(world, event.index, temperature);
+        }
+    }
+
+    // Apply the batch: bodies in place, voxels through one copy-on-write edit
+    for (const auto& swap : bodySwaps) {
+        world.setMaterial(swap.first, swap.second, settings.conserveMass);
+        scheduleBody(world, swap.first, world.getTemperature(swap.first));
+    }
+
+    if (!voxelTemperatures.empty()) {
+        // Voxel events only exist for a world with a medium grid
+        MediumGrid& medium = *world.editMedium();
+        float* temperatures = medium.getTemperatures();
+        MaterialId* cells = medium.getCells();
+        for (const auto& entry : voxelTemperatures) {
+            temperatures[entry.first] = static_cast<float>(entry.second);
+        }
+        for (const auto& swap : voxelSwaps) {
+            cells[swap.first] = swap.second;
+            scheduleVoxel(world, swap.first, temperatures[swap.first]);
+        }
+    }
+
+    return bodySwaps.size() + voxelSwaps.size();
+}
+
+double PhaseTransitions::getBodyTemperature(const World& world, BodyId id) const {
+    if (id < bodies.size() && bodies[id].version != 0) {
+        return relax(bodies[id], world.getTime());
+    }
+    return world.getTemperature(id);
+}
+
+double PhaseTransitions::getVoxelTemperature(const World& world, size_t cell) const {
+    auto found = voxels.find(cell);
+    if (found != voxels.end() && found->second.version != 0) {
+        return relax(found->second, world.getTime());
+    }
+    const MediumGrid* medium = world.getMedium();
+    return medium && cell < medium->getCellCount() ? double(medium->getTemperatures()[cell]) : 0.0;
+}
+
+} // namespace archimedes3d
@@ -0,0 +1,548 @@
+#include "../include/sph.h"
+#include "../../core/include/profiler.h"
+#include "../../core/include/thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace archimedes3d {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+constexpr size_t kLanes = 8;            // Neighbour loop width, one AVX register of floats
+constexpr size_t kParticleGrain = 1024; // Particles per parallel chunk
+constexpr float kMinDistanceSquared = 1.0e-12f;
+
+// Spread the low 21 bits of v so they occupy every third bit
+uint64_t spreadBits(uint64_t v) {
+    v &= 0x1fffff;
+    v = (v | (v << 32)) & 0x1f00000000ffffULL;
+    v = (v | (v << 16)) & 0x1f0000ff0000ffULL;
+    v = (v | (v << 8)) & 0x100f00f00f00f00fULL;
+    v = (v | (v << 4)) & 0x10c30c30c30c30c3ULL;
+    v = (v | (v << 2)) & 0x1249249249249249ULL;
+    return v;
+}
+
+uint32_t cellsAlong(double min, double max, float support) {
+    return std::max<uint32_t>(1, static_cast<uint32_t>(std::ceil((max - min) / support)));
+}
+
+} // namespace
+
+SphFluid::SphFluid(std::shared_ptr<LiquidMaterial> liquid, const SphSettings& settings)
+    : liquid(std::move(liquid))
+    , settings(settings)
+    , gridValid(false)
+{
+    const double spacing = settings.particleSpacing;
+    const double h = spacing * settings.supportRatio;
+    const double rho0 = this->liquid->getDensity();
+
+    support = static_cast<float>(h);
+    restDensity = static_cast<float>(rho0);
+    particleMass = static_cast<float>(rho0 * spacing * spacing * spacing);
+    stiffness = static_cast<float>(rho0 * settings.speedOfSound * settings.speedOfSound / 7.0);
+    kinematicViscosity = static_cast<float>(this->liquid->getViscosity() / rho0);
+    artificialViscosity = static_cast<float>(settings.artificialViscosity * settings.speedOfSound * h);
+
+    // Cohesion a = -κ·Σ m_j·(x_i - x_j)·W(r); κ = σ / (ρ0²·s³) keeps units and
+    // scales the pull with the material's surface tension
+    cohesion = static_cast<float>(this->liquid->getSurfaceTension() / (rho0 * rho0 * spacing * spacing * spacing));
+
+    poly6Coefficient = static_cast<float>(315.0 / (64.0 * kPi * std::pow(h, 9)));
+    spikyCoefficient = static_cast<float>(45.0 / (kPi * std::pow(h, 6)));
+
+    cellsX = cellsAlong(settings.boundsMin.x, settings.boundsMax.x, support);
+    cellsY = cellsAlong(settings.boundsMin.y, settings.boundsMax.y, support);
+    cellsZ = cellsAlong(settings.boundsMin.z, settings.boundsMax.z, support);
+
+    const size_t cellTotal = size_t(cellsX) * cellsY * cellsZ;
+    cellStart.assign(cellTotal, 0);
+    cellCount.assign(cellTotal, 0);
+}
+
+size_t SphFluid::addParticle(const Vector3& position, const Vector3& velocity) {
+    positionX.push_back(static_cast<float>(position.x));
+    positionY.push_back(static_cast<float>(position.y));
+    positionZ.push_back(static_cast<float>(position.z));
+    velocityX.push_back(static_cast<float>(velocity.x));
+    velocityY.push_back(static_cast<float>(velocity.y));
+    velocityZ.push_back(static_cast<float>(velocity.z));
+    accelerationX.push_back(0.0f);
+    accelerationY.push_back(0.0f);
+    accelerationZ.push_back(0.0f);
+    density.push_back(restDensity);
+    pressure.push_back(0.0f);
+    particleCell.push_back(0);
+
+    gridValid = false;
+    return positionX.size() - 1;
+}
+
+size_t SphFluid::fillBox(const Vector3& min, const Vector3& max) {
+    const double spacing = settings.particleSpacing;
+    const double half = 0.5 * spacing;
+    size_t added = 0;
+
+    for (double z = min.z + half; z < max.z; z += spacing) {
+        for (double y = min.y + half; y < max.y; y += spacing) {
+            for (double x = min.x + half; x < max.x; x += spacing) {
+                addParticle(Vector3(x, y, z));
+                ++added;
+            }
+        }
+    }
+    return added;
+}
+
+size_t SphFluid::addRigidBody(const SphRigidBody& body) {
+    bodies.push_back(body);
+    bodyImpulse.push_back(Vector3());
+    return bodies.size() - 1;
+}
+
+Vector3 SphFluid::getParticlePosition(size_t index) const {
+    return Vector3(positionX[index], positionY[index], positionZ[index]);
+}
+
+Vector3 SphFluid::getParticleVelocity(size_t index) const {
+    return Vector3(velocityX[index], velocityY[index], velocityZ[index]);
+}
+
+uint32_t SphFluid::cellOf(float x, float y, float z) const {
+    const float inverse = 1.0f / support;
+    auto axis = [inverse](float value, double min, uint32_t cells) {
+        const float scaled = (value - static_cast<float>(min)) * inverse;
+        return static_cast<uint32_t>(std::clamp(scaled, 0.0f, float(cells - 1)));
+    };
+    const uint32_t cx = axis(x, settings.boundsMin.x, cellsX);
+    const uint32_t cy = axis(y, settings.boundsMin.y, cellsY);
+    const uint32_t cz = axis(z, settings.boundsMin.z, cellsZ);
+    return cx + cellsX * (cy + cellsY * cz);
+}
+
+uint64_t SphFluid::mortonOf(uint32_t cell) const {
+    const uint32_t cx = cell % cellsX;
+    const uint32_t cy = (cell / cellsX) % cellsY;
+    const uint32_t cz = cell / (cellsX * cellsY);
+    return spreadBits(cx) | (spreadBits(cy) << 1) | (spreadBits(cz) << 2);
+}
+
+double SphFluid::calculateStableTimeStep() const {
+    // CFL on the speed of sound, viscous diffusion and body-force limits
+    const double h = support;
+    double dt = 0.4 * h / settings.speedOfSound;
+    if (kinematicViscosity > 0.0f) {
+        dt = std::min(dt, 0.125 * h * h / kinematicViscosity);
+    }
+    const double g = settings.gravity.length();
+    if (g > 0.0) {
+        dt = std::min(dt, 0.25 * std::sqrt(h / g));
+    }
+    return dt;
+}
+
+void SphFluid::step(double dt, ThreadPool& pool) {
+    if (dt <= 0.0) return;
+
+    const int substeps = std::max(1, static_cast<int>(std::ceil(dt / calculateStableTimeStep())));
+    const float subDt = static_cast<float>(dt / substeps);
+
+    std::fill(bodyImpulse.begin(), bodyImpulse.end(), Vector3());
+    for (int i = 0; i < substeps; ++i) {
+        substep(subDt, pool);
+    }
+    for (size_t b = 0; b < bodies.size(); ++b) {
+        bodies[b].fluidForce = bodyImpulse[b] / dt;
+    }
+}
+
+void SphFluid::substep(float dt, ThreadPool& pool) {
+    updateGrid(pool);
+    computeDensity(pool);
+    computeForces(pool);
+    integrateParticles(dt, pool);
+    coupleRigidBodies(dt);
+}
+
+void SphFluid::updateGrid(ThreadPool& pool) {
+    ARCHIMEDES3D_PROFILE_SCOPE("sph grid");
+    const size_t count = getParticleCount();
+    const size_t chunkCount = (count + kParticleGrain - 1) / kParticleGrain;
+    sortKeys.resize(count);
+    chunkMovers.resize(chunkCount + 1);
+
+    // Recompute cells in the current (previously sorted) order and count movers per chunk
+    pool.parallelFor(chunkCount, 1, [&](size_t chunkBegin, size_t chunkEnd) {
+        for (size_t chunk = chunkBegin; chunk < chunkEnd; ++chunk) {
+            const size_t end = std::min(count, (chunk + 1) * kParticleGrain);
+            uint32_t movers = 0;
+            for (size_t i = chunk * kParticleGrain; i < end; ++i) {
+                const uint32_t cell = cellOf(positionX[i], positionY[i], positionZ[i]);
+                movers += cell != particleCell[i];
+                sortKeys[i] = SortKey{mortonOf(cell), cell, static_cast<uint32_t>(i)};
+            }
+            chunkMovers[chunk] = movers;
+        }
+    });
+
+    // Exclusive prefix: chunkMovers[c] becomes the first mover slot of chunk c
+    size_t moved = 0;
+    for (size_t chunk = 0; chunk <= chunkCount; ++chunk) {
+        const size_t movers = chunk < chunkCount ? chunkMovers[chunk] : 0;
+        chunkMovers[chunk] = static_cast<uint32_t>(moved);
+        moved += movers;
+    }
+
+    if (gridValid && moved == 0) return;
+
+    if (gridValid) {
+        // Clear the cells that were occupied; particleCell is still in sorted runs,
+        // so the first particle of each run clears its cell
+        pool.parallelFor(count, kParticleGrain, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                if (i == 0 || particleCell[i] != particleCell[i - 1]) cellCount[particleCell[i]] = 0;
+            }
+        });
+    } else {
+        pool.parallelFor(cellCount.size(), kParticleGrain * 16, [&](size_t begin, size_t end) {
+            std::fill(cellCount.begin() + begin, cellCount.begin() + end, 0u);
+        });
+    }
+
+    auto before = [](const SortKey& a, const SortKey& b) {
+        return a.morton < b.morton || (a.morton == b.morton && a.index < b.index);
+    };
+
+    if (gridValid && moved <= settings.rebuildSortFraction * count) {
+        // Particles that kept their cell are still sorted: split off the movers,
+        // sort only those and merge them back, O(n + m·log m) for m movers
+        moverKeys.resize(moved);
+        stayKeys.resize(count - moved);
+        pool.parallelFor(chunkCount, 1, [&](size_t chunkBegin, size_t chunkEnd) {
+            for (size_t chunk = chunkBegin; chunk < chunkEnd; ++chunk) {
+                const size_t begin = chunk * kParticleGrain;
+                const size_t end = std::min(count, begin + kParticleGrain);
+                size_t mover = chunkMovers[chunk];
+                size_t stay = begin - mover;
+                for (size_t i = begin; i < end; ++i) {
+                    if (sortKeys[i].cell != particleCell[i]) {
+                        moverKeys[mover++] = sortKeys[i];
+                    } else {
+                        stayKeys[stay++] = sortKeys[i];
+                    }
+                }
+            }
+        });
+        std::sort(moverKeys.begin(), moverKeys.end(), before);
+        std::merge(stayKeys.begin(), stayKeys.end(), moverKeys.begin(), moverKeys.end(), sortKeys.begin(), before);
+    } else {
+        std::sort(sortKeys.begin(), sortKeys.end(), before);
+    }
+
+    // Gather particle state into the new order
+    std::atomic<bool> reordered{false};
+    pool.parallelFor(count, kParticleGrain, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (sortKeys[i].index != i) {
+                reordered.store(true, std::memory_order_relaxed);
+                break;
+            }
+        }
+    });
+    if (reordered.load()) {
+        scratch.resize(count);
+        for (std::vector<float>* array : {&positionX, &positionY, &positionZ,
+                                          &velocityX, &velocityY, &velocityZ}) {
+            std::vector<float>& values = *array;
+            pool.parallelFor(count, kParticleGrain, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    scratch[i] = values[sortKeys[i].index];
+                }
+            });
+            values.swap(scratch);
+        }
+    }
+
+    // Rebuild the cell table: the first particle of each run writes its cell's entry
+    pool.parallelFor(count, kParticleGrain, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const uint32_t cell = sortKeys[i].cell;
+            particleCell[i] = cell;
+            if (i > 0 && sortKeys[i - 1].cell == cell) continue;
+
+            size_t last = i + 1;
+            while (last < count && sortKeys[last].cell == cell) ++last;
+            cellStart[cell] = static_cast<uint32_t>(i);
+            cellCount[cell] = static_cast<uint32_t>(last - i);
+        }
+    });
+    gridValid = true;
+}
+
+void SphFluid::computeDensity(ThreadPool& pool) {
+    ARCHIMEDES3D_PROFILE_SCOPE("sph density");
+    const float h2 = support * support;
+    const float mass = particleMass;
+    const float poly6 = poly6Coefficient;
+    const float rho0 = restDensity;
+    const float b = stiffness;
+
+    const float* px = positionX.data();
+    const float* py = positionY.data();
+    const float* pz = positionZ.data();
+
+    pool.parallelFor(getParticleCount(), kParticleGrain, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const float xi = px[i], yi = py[i], zi = pz[i];
+            const uint32_t cell = particleCell[i];
+            const int cx = int(cell % cellsX);
+            const int cy = int((cell / cellsX) % cellsY);
+            const int cz = int(cell / (cellsX * cellsY));
+
+            float lanes[kLanes] = {};
+            float sum = 0.0f;
+
+            for (int z = std::max(cz - 1, 0); z <= std::min(cz + 1, int(cellsZ) - 1); ++z) {
+                for (int y = std::max(cy - 1, 0); y <= std::min(cy + 1, int(cellsY) - 1); ++y) {
+                    for (int x = std::max(cx - 1, 0); x <= std::min(cx + 1, int(cellsX) - 1); ++x) {
+                        const uint32_t neighbour = uint32_t(x) + cellsX * (uint32_t(y) + cellsY * uint32_t(z));
+                        size_t j = cellStart[neighbour];
+                        const size_t last = j + cellCount[neighbour];
+
+                        // W_poly6 = c·(h² - r²)³ inside the support
+                        for (; j + kLanes <= last; j += kLanes) {
+                            for (size_t l = 0; l < kLanes; ++l) {
+                                const float dx = xi - px[j + l], dy = yi - py[j + l], dz = zi - pz[j + l];
+                                const float q = std::max(h2 - (dx * dx + dy * dy + dz * dz), 0.0f);
+                                lanes[l] += q * q * q;
+                            }
+                        }
+                        for (; j < last; ++j) {
+                            const float dx = xi - px[j], dy = yi - py[j], dz = zi - pz[j];
+                            const float q = std::max(h2 - (dx * dx + dy * dy + dz * dz), 0.0f);
+                            sum += q * q * q;
+                        }
+                    }
+                }
+            }
+
+            for (size_t l = 0; l < kLanes; ++l) sum += lanes[l];
+            const float rho = std::max(mass * poly6 * sum, 1.0e-6f);
+            density[i] = rho;
+
+            // Tait equation, clamped at zero to avoid tensile clumping at the free surface
+            const float ratio = rho / rho0;
+            const float ratio7 = ratio * ratio * ratio * ratio * ratio * ratio * ratio;
+            pressure[i] = std::max(b * (ratio7 - 1.0f), 0.0f);
+        }
+    });
+}
+
+void SphFluid::computeForces(ThreadPool& pool) {
+    ARCHIMEDES3D_PROFILE_SCOPE("sph forces");
+    const float h = support;
+    const float h2 = h * h;
+    const float mass = particleMass;
+    const float poly6 = poly6Coefficient;
+    const float spiky = spikyCoefficient;
+    const float nu = kinematicViscosity;
+    const float alpha = artificialViscosity;
+    const float kappa = cohesion;
+
+    const float* px = positionX.data();
+    const float* py = positionY.data();
+    const float* pz = positionZ.data();
+    const float* vx = velocityX.data();
+    const float* vy = velocityY.data();
+    const float* vz = velocityZ.data();
+    const float* rho = density.data();
+    const float* p = pressure.data();
+
+    pool.parallelFor(getParticleCount(), kParticleGrain, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const float xi = px[i], yi = py[i], zi = pz[i];
+            const float vxi = vx[i], vyi = vy[i], vzi = vz[i];
+            const float pressureTerm = p[i] / (rho[i] * rho[i]);
+            const float rhoi = rho[i];
+
+            const uint32_t cell = particleCell[i];
+            const int cx = int(cell % cellsX);
+            const int cy = int((cell / cellsX) % cellsY);
+            const int cz = int(cell / (cellsX * cellsY));
+
+            float ax[kLanes] = {}, ay[kLanes] = {}, az[kLanes] = {};
+            float sx = 0.0f, sy = 0.0f, sz = 0.0f;
+
+            // Pair acceleration on i from j; zero outside the support and for j == i
+            auto pair = [&](size_t j, float& outX, float& outY, float& outZ) {
+                const float dx = xi - px[j], dy = yi - py[j], dz = zi - pz[j];
+                const float r2 = dx * dx + dy * dy + dz * dz;
+                const float inside = (r2 < h2 && r2 > kMinDistanceSquared) ? 1.0f : 0.0f;
+                const float r = std::sqrt(std::max(r2, kMinDistanceSquared));
+                const float falloff = std::max(h - r, 0.0f);
+
+                // Monaghan artificial viscosity, only for approaching pairs
+                const float approach = std::min(dx * (vxi - vx[j]) + dy * (vyi - vy[j]) + dz * (vzi - vz[j]), 0.0f);
+                const float dissipation = -alpha * approach / ((r2 + 0.01f * h2) * 0.5f * (rhoi + rho[j]));
+
+                // Pressure: -m_j·(p_i/ρ_i² + p_j/ρ_j² + Π_ij)·∇W_spiky
+                const float pressureScale = mass * (pressureTerm + p[j] / (rho[j] * rho[j]) + dissipation) *
+                                            spiky * falloff * falloff / r;
+                // Viscosity: ν·m_j·(v_j - v_i)/ρ_j·∇²W_viscosity
+                const float viscosityScale = nu * mass / rho[j] * spiky * falloff;
+                // Cohesion: -κ·m_j·(x_i - x_j)·W_poly6
+                const float q = std::max(h2 - r2, 0.0f);
+                const float cohesionScale = kappa * mass * poly6 * q * q * q;
+
+                const float radial = inside * (pressureScale - cohesionScale);
+                outX += radial * dx + inside * viscosityScale * (vx[j] - vxi);
+                outY += radial * dy + inside * viscosityScale * (vy[j] - vyi);
+                outZ += radial * dz + inside * viscosityScale * (vz[j] - vzi);
+            };
+
+            for (int z = std::max(cz - 1, 0); z <= std::min(cz + 1, int(cellsZ) - 1); ++z) {
+                for (int y = std::max(cy - 1, 0); y <= std::min(cy + 1, int(cellsY) - 1); ++y) {
+                    for (int x = std::max(cx - 1, 0); x <= std::min(cx + 1, int(cellsX) - 1); ++x) {
+                        const uint32_t neighbour = uint32_t(x) + cellsX * (uint32_t(y) + cellsY * uint32_t(z));
+                        size_t j = cellStart[neighbour];
+                        const size_t last = j + cellCount[neighbour];
+
+                        for (; j + kLanes <= last; j += kLanes) {
+                            for (size_t l = 0; l < kLanes; ++l) {
+                                pair(j + l, ax[l], ay[l], az[l]);
+                            }
+                        }
+                        for (; j < last; ++j) {
+                            pair(j, sx, sy, sz);
+                        }
+                    }
+                }
+            }
+
+            for (size_t l = 0; l < kLanes; ++l) {
+                sx += ax[l];
+                sy += ay[l];
+                sz += az[l];
+            }
+            accelerationX[i] = sx;
+            accelerationY[i] = sy;
+            accelerationZ[i] = sz;
+        }
+    });
+}
+
+void SphFluid::integrateParticles(float dt, ThreadPool& pool) {
+    ARCHIMEDES3D_PROFILE_SCOPE("sph integrate");
+    const float gx = static_cast<float>(settings.gravity.x);
+    const float gy = static_cast<float>(settings.gravity.y);
+    const float gz = static_cast<float>(settings.gravity.z);
+    const float restitution = static_cast<float>(settings.wallRestitution);
+
+    auto wall = [restitution](float& position, float& velocity, float min, float max) {
+        if (position < min) {
+            position = min;
+            if (velocity < 0.0f) velocity = -velocity * restitution;
+        } else if (position > max) {
+            position = max;
+            if (velocity > 0.0f) velocity = -velocity * restitution;
+        }
+    };
+
+    const float minX = float(settings.boundsMin.x), maxX = float(settings.boundsMax.x);
+    const float minY = float(settings.boundsMin.y), maxY = float(settings.boundsMax.y);
+    const float minZ = float(settings.boundsMin.z), maxZ = float(settings.boundsMax.z);
+
+    pool.parallelFor(getParticleCount(), kParticleGrain, [&](size_t begin, size_t end) {
+        // Symplectic Euler
+        for (size_t i = begin; i < end; ++i) {
+            velocityX[i] += (accelerationX[i] + gx) * dt;
+            velocityY[i] += (accelerationY[i] + gy) * dt;
+            velocityZ[i] += (accelerationZ[i] + gz) * dt;
+            positionX[i] += velocityX[i] * dt;
+            positionY[i] += velocityY[i] * dt;
+            positionZ[i] += velocityZ[i] * dt;
+        }
+        for (size_t i = begin; i < end; ++i) {
+            wall(positionX[i], velocityX[i], minX, maxX);
+            wall(positionY[i], velocityY[i], minY, maxY);
+            wall(positionZ[i], velocityZ[i], minZ, maxZ);
+        }
+    });
+}
+
+void SphFluid::coupleRigidBodies(float dt) {
+    ARCHIMEDES3D_PROFILE_SCOPE("sph coupling");
+    const double skin = 0.5 * settings.particleSpacing;
+    const double particleInverseMass = 1.0 / particleMass;
+
+    for (size_t b = 0; b < bodies.size(); ++b) {
+        SphRigidBody& body = bodies[b];
+        body.velocity += settings.gravity * double(dt);
+        body.position += body.velocity * double(dt);
+
+        // Keep the body inside the container
+        for (double Vector3::*axis : {&Vector3::x, &Vector3::y, &Vector3::z}) {
+            const double min = settings.boundsMin.*axis + body.radius;
+            const double max = settings.boundsMax.*axis - body.radius;
+            if (body.position.*axis < min) {
+                body.position.*axis = min;
+                body.velocity.*axis = std::max(body.velocity.*axis, 0.0);
+            } else if (body.position.*axis > max) {
+                body.position.*axis = max;
+                body.velocity.*axis = std::min(body.velocity.*axis, 0.0);
+            }
+        }
+
+        // Push overlapping particles to the surface and exchange normal momentum
+        const double reach = body.radius + skin;
+        const double bodyInverseMass = 1.0 / body.mass;
+        const uint32_t low = cellOf(float(body.position.x - reach), float(body.position.y - reach),
+                                    float(body.position.z - reach));
+        const uint32_t high = cellOf(float(body.position.x + reach), float(body.position.y + reach),
+                                     float(body.position.z + reach));
+
+        for (uint32_t z = low / (cellsX * cellsY); z <= high / (cellsX * cellsY); ++z) {
+            for (uint32_t y = (low / cellsX) % cellsY; y <= (high / cellsX) % cellsY; ++y) {
+                for (uint32_t x = low % cellsX; x <= high % cellsX; ++x) {
+                    const uint32_t cell = x + cellsX * (y + cellsY * z);
+                    const size_t first = cellStart[cell];
+                    const size_t last = first + cellCount[cell];
+
+                    for (size_t j = first; j < last; ++j) {
+                        Vector3 offset(positionX[j] - body.position.x, positionY[j] - body.position.y,
+                                       positionZ[j] - body.position.z);
+                        const double distance = offset.length();
+                        if (distance >= reach || distance <= 0.0) continue;
+
+                        const Vector3 normal = offset / distance;
+                        const Vector3 surface = body.position + normal * reach;
+                        positionX[j] = float(surface.x);
+                        positionY[j] = float(surface.y);
+                        positionZ[j] = float(surface.z);
+
+                        const Vector3 velocity(velocityX[j], velocityY[j], velocityZ[j]);
+                        const double approach = (velocity - body.velocity).dot(normal);
+                        if (approach >= 0.0) continue;
+
+                        // Inelastic normal impulse shared by particle and body
+                        const double impulse = -approach / (particleInverseMass + bodyInverseMass);
+                        const Vector3 particleVelocity = velocity + normal * (impulse * particleInverseMass);
+                        velocityX[j] = float(particleVelocity.x);
+                        velocityY[j] = float(particleVelocity.y);
+                        velocityZ[j] = float(particleVelocity.z);
+
+                        body.velocity -= normal * (impulse * bodyInverseMass);
+                        bodyImpulse[b] -= normal * impulse;
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace archimedes3d